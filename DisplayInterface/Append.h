@@ -0,0 +1,42 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Append.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Ways of appending to a name
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Ways of appending to a name (see DisplayInterface::add())
+/////////////////////////////////////////////////////////////////
+struct Append
+{
+    /// @brief   Keep only the most recent appends to a name, as a ring
+    ///
+    /// @code
+    /// // the last 500 poses of the odometry trail
+    /// d3::di().add( "odometry::trail", d3::get(d3::Triad{pose}), d3::Append::Window{500} );
+    ///
+    /// // the scans of the last ten seconds
+    /// d3::di().add( "lidar::history", d3::get(scan), d3::Append::Window{0, 10.0} );
+    /// @endcode
+    struct Window
+    {
+        /// The most appends kept (0 for no limit)
+        size_t count;
+
+        /// The oldest append kept, in seconds (0 for no limit)
+        double seconds;
+    };
+};
+
+} // namespace d3
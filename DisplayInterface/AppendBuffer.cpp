@@ -0,0 +1,223 @@
+/////////////////////////////////////////////////////////////////
+/// @file      AppendBuffer.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Growing geometry that streamed point and line appends are merged
+///            into
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "AppendBuffer.h"
+
+#include <DDDisplayObjects/Colors.h>
+
+#include <osg/Version>
+
+namespace d3
+{
+
+namespace
+{
+
+/// How the colors of a geometry are bound
+enum class ColorBinding
+{
+    PER_VERTEX = 0,
+    OVERALL,
+    OTHER
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   How the colors of a geometry are bound
+/////////////////////////////////////////////////////////////////
+ColorBinding colorBinding(const osg::Geometry* geometry)
+{
+#if      OSG_MIN_VERSION_REQUIRED(3,2,0)
+    switch ( geometry->getColorArray()->getBinding() )
+    {
+    case osg::Array::BIND_PER_VERTEX: return ColorBinding::PER_VERTEX;
+    case osg::Array::BIND_OVERALL:    return ColorBinding::OVERALL;
+    default:                          return ColorBinding::OTHER;
+    }
+#else    // OSG_MIN_VERSION_REQUIRED(3,2,0)
+    switch ( geometry->getColorBinding() )
+    {
+    case osg::Geometry::BIND_PER_VERTEX: return ColorBinding::PER_VERTEX;
+    case osg::Geometry::BIND_OVERALL:    return ColorBinding::OVERALL;
+    default:                             return ColorBinding::OTHER;
+    }
+#endif   // OSG_MIN_VERSION_REQUIRED(3,2,0)
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The geometry of a node if it can be merged into a buffer
+/// @return  The geometry, null if the node can't be merged
+/////////////////////////////////////////////////////////////////
+const osg::Geometry* mergeable(const osg::Node* node)
+{
+    // a plain geode with a single geometry
+    const osg::Geode* geode( dynamic_cast<const osg::Geode*>(node) );
+    if ( (nullptr == geode) || (nullptr != dynamic_cast<const AppendBuffer*>(geode)) ) return nullptr;
+    if ( (~0u != geode->getNodeMask()) || (nullptr != geode->getStateSet()) ) return nullptr;
+    if ( 1 != geode->getNumDrawables() ) return nullptr;
+    const osg::Geometry* geometry( geode->getDrawable(0)->asGeometry() );
+    if ( nullptr == geometry ) return nullptr;
+
+    // float vertices and colors, nothing else
+    const osg::Vec3Array* vertices( dynamic_cast<const osg::Vec3Array*>(geometry->getVertexArray()) );
+    if ( (nullptr == vertices) || vertices->empty() ) return nullptr;
+    if ( (nullptr != geometry->getNormalArray()) || (0 != geometry->getNumTexCoordArrays()) ) return nullptr;
+
+    const osg::Array* colors( geometry->getColorArray() );
+    if ( (nullptr == dynamic_cast<const osg::Vec4Array*>(colors)) &&
+         (nullptr == dynamic_cast<const osg::Vec4ubArray*>(colors)) ) return nullptr;
+    switch ( colorBinding(geometry) )
+    {
+    case ColorBinding::PER_VERTEX: if ( colors->getNumElements() != vertices->size() ) return nullptr; break;
+    case ColorBinding::OVERALL:    if ( 0 == colors->getNumElements() )                return nullptr; break;
+    default:                                                                           return nullptr;
+    }
+
+    // all the vertices as points or lines, in order
+    if ( 1 != geometry->getNumPrimitiveSets() ) return nullptr;
+    const osg::PrimitiveSet* primitives( geometry->getPrimitiveSet(0) );
+    if ( (osg::PrimitiveSet::POINTS != primitives->getMode()) &&
+         (osg::PrimitiveSet::LINES  != primitives->getMode()) ) return nullptr;
+    if ( primitives->getNumIndices() != vertices->size() ) return nullptr;
+    for ( unsigned int ii(0) ; ii<primitives->getNumIndices() ; ++ii )
+        if ( ii != primitives->index(ii) ) return nullptr;
+
+    return geometry;
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool AppendBuffer::append(osg::Group* group,
+                          const osg::Node* node)
+{
+    const osg::Geometry* geometry( mergeable(node) );
+    if ( nullptr == geometry ) return false;
+
+    // keep going in the buffer at the end of the group, or start one
+    const GLenum mode( geometry->getPrimitiveSet(0)->getMode() );
+    AppendBuffer* buffer( (0 == group->getNumChildren()) ? nullptr :
+                          dynamic_cast<AppendBuffer*>(group->getChild(group->getNumChildren() - 1)) );
+    if ( (nullptr == buffer) || not buffer->accepts(mode, geometry->getStateSet()) )
+    {
+        buffer = new AppendBuffer(mode, geometry->getStateSet());
+        group->addChild(buffer);
+    }
+
+    buffer->add(geometry);
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+AppendBuffer::~AppendBuffer()
+{
+};
+
+/////////////////////////////////////////////////////////////////
+//////// PRIVATES //////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+AppendBuffer::AppendBuffer(const GLenum& mode,
+                           const osg::StateSet* stateSet) :
+    osg::Geode(),
+    m_mode(mode),
+    m_pVertices(),
+    m_pColors(),
+    m_pDrawArrays(),
+    m_pChunk()
+{
+    // the merged geometries all had this state, the chunks share it
+    if ( nullptr != stateSet )
+        setStateSet(new osg::StateSet(*stateSet, osg::CopyOp::SHALLOW_COPY));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool AppendBuffer::accepts(const GLenum& mode,
+                           const osg::StateSet* stateSet) const
+{
+    if ( mode != m_mode ) return false;
+
+    const osg::StateSet* mine( getStateSet() );
+    if ( (nullptr == mine) || (nullptr == stateSet) ) return mine == stateSet;
+    return 0 == mine->compare(*stateSet, true);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void AppendBuffer::add(const osg::Geometry* geometry)
+{
+    const osg::Vec3Array* vertices( static_cast<const osg::Vec3Array*>(geometry->getVertexArray()) );
+
+    // a chunk never splits an add, so lines stay in pairs
+    if ( (nullptr == m_pChunk) ||
+         (not m_pVertices->empty() && (m_pVertices->size() + vertices->size() > chunkSize)) )
+        addChunk();
+
+    m_pVertices->insert(m_pVertices->end(), vertices->begin(), vertices->end());
+
+    const bool overall( ColorBinding::OVERALL == colorBinding(geometry) );
+    if ( const osg::Vec4ubArray* colors = dynamic_cast<const osg::Vec4ubArray*>(geometry->getColorArray()) )
+    {
+        if ( overall ) m_pColors->resize(m_pVertices->size(), colors->front());
+        else           m_pColors->insert(m_pColors->end(), colors->begin(), colors->end());
+    }
+    else
+    {
+        const osg::Vec4Array* floatColors( static_cast<const osg::Vec4Array*>(geometry->getColorArray()) );
+        if ( overall )
+        {
+            m_pColors->resize(m_pVertices->size(), toBytes(floatColors->front()));
+        }
+        else
+        {
+            for ( const osg::Vec4& color : *floatColors )
+                m_pColors->push_back(toBytes(color));
+        }
+    }
+
+    // only this chunk is uploaded again
+    m_pDrawArrays->setCount(m_pVertices->size());
+    m_pVertices->dirty();
+    m_pColors->dirty();
+    m_pDrawArrays->dirty();
+    m_pChunk->dirtyBound();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void AppendBuffer::addChunk()
+{
+    m_pVertices = new osg::Vec3Array();
+    m_pColors = new osg::Vec4ubArray();
+    m_pColors->setNormalize(true);
+    m_pDrawArrays = new osg::DrawArrays(m_mode, 0, 0);
+
+    m_pChunk = new osg::Geometry();
+    m_pChunk->setDataVariance(osg::Object::DYNAMIC);
+    m_pChunk->setUseDisplayList(false);
+    m_pChunk->setUseVertexBufferObjects(true);
+    m_pChunk->setVertexArray(m_pVertices);
+#if      OSG_MIN_VERSION_REQUIRED(3,2,0)
+    m_pChunk->setColorArray(m_pColors, osg::Array::Binding::BIND_PER_VERTEX);
+#else    // OSG_MIN_VERSION_REQUIRED(3,2,0)
+    m_pChunk->setColorArray(m_pColors);
+    m_pChunk->setColorBinding(osg::Geometry::BIND_PER_VERTEX);
+#endif   // OSG_MIN_VERSION_REQUIRED(3,2,0)
+    m_pChunk->addPrimitiveSet(m_pDrawArrays);
+
+    addDrawable(m_pChunk);
+};
+
+} // namespace d3
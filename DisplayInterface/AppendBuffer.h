@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////
+/// @file      AppendBuffer.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Growing geometry that streamed point and line appends are merged
+///            into
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/PrimitiveSet>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The points or lines appended to a name, in a few large geometries
+///          rather than one geode each
+///
+/// An add with replace=false of the output of d3::get() for points or lines
+/// has its vertices and colors copied onto the end of the last chunk, and the
+/// chunk's draw count grows. The arrays grow like vectors (amortized) and only
+/// the last chunk is dirtied, so each frame uploads at most one chunk and a
+/// full chunk is never uploaded again - a million point trail is a handful of
+/// draw calls instead of a million geodes with their own state.
+/////////////////////////////////////////////////////////////////
+class AppendBuffer : public osg::Geode
+{
+  public:
+
+    /// The most vertices in a chunk - the most uploaded per frame
+    static const unsigned int chunkSize = 1u << 16;
+
+    /// @brief   Merge a node into the buffer at the end of a group
+    /// @param   group The group the node is being appended to
+    /// @param   node The node
+    /// @return  boolean True if the node was merged, false if it can't be
+    ///          (and nothing was done)
+    /// @note    Only call this with the osg lock held
+    ///
+    /// A node can be merged if it is a geode with a single geometry of only
+    /// points or lines drawn in order, with float vertices and per-vertex or
+    /// overall colors. A new buffer is started at the end of the group if the
+    /// last child isn't a buffer of the same mode and state.
+    static bool append(osg::Group* group,
+                       const osg::Node* node);
+
+  protected:
+
+    /// @brief   Destructor
+    virtual ~AppendBuffer();
+
+  private:
+
+    /// @brief   Constructor
+    /// @param   mode The primitive mode (points or lines)
+    /// @param   stateSet The state of the merged geometries (may be null)
+    AppendBuffer(const GLenum& mode,
+                 const osg::StateSet* stateSet);
+
+    /// @brief   Can a geometry with this mode and state go in here
+    bool accepts(const GLenum& mode,
+                 const osg::StateSet* stateSet) const;
+
+    /// @brief   Copy the vertices and colors of a geometry onto the end
+    void add(const osg::Geometry* geometry);
+
+    /// @brief   Start a new chunk
+    void addChunk();
+
+    /// The primitive mode
+    GLenum                          m_mode;
+
+    /// The vertices of the last chunk
+    osg::ref_ptr<osg::Vec3Array>    m_pVertices;
+
+    /// The colors of the last chunk
+    osg::ref_ptr<osg::Vec4ubArray>  m_pColors;
+
+    /// Draws the last chunk
+    osg::ref_ptr<osg::DrawArrays>   m_pDrawArrays;
+
+    /// The last chunk
+    osg::ref_ptr<osg::Geometry>     m_pChunk;
+};
+
+} // namespace d3
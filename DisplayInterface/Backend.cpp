@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Backend.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Select at runtime what the display interface does with what it
+///            is given
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "Backend.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace d3
+{
+
+namespace
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The backend asked for by the environment
+/////////////////////////////////////////////////////////////////
+Backend fromEnvironment()
+{
+    const char* value( std::getenv("D3_BACKEND") );
+    if ( nullptr == value ) return Backend::DISPLAY;
+
+    const std::string name( value );
+    if ( name.empty() || ("display" == name) ) return Backend::DISPLAY;
+    if ( ("none" == name) || ("null" == name) ) return Backend::NONE;
+    if ( "stats" == name ) return Backend::STATS;
+
+    std::cerr << "BUMMER: Unknown D3_BACKEND '" << name << "', using display" << std::endl;
+    return Backend::DISPLAY;
+};
+
+} // namespace
+
+namespace detail
+{
+std::atomic<Backend> g_backend( fromEnvironment() );
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void setBackend(const Backend& backend)
+{
+    detail::g_backend.store(backend, std::memory_order_relaxed);
+};
+
+} // namespace d3
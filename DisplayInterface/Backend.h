@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Backend.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Select at runtime what the display interface does with what it
+///            is given
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+
+namespace d3
+{
+
+/// @brief   What d3::di() does with what it is given
+enum class Backend
+{
+    DISPLAY = 0, ///< Show it in the window (the default)
+    NONE,        ///< Throw it away - no window, no display thread, no qt
+    STATS        ///< Only count the calls and bytes for each name (see
+                 ///< DisplayInterface::getStats())
+};
+
+#ifdef   D3_DISABLE
+
+/// @brief   Compiled out - there is nothing to select
+inline void setBackend(const Backend&) {}
+
+/// @brief   Compiled out - always NONE
+inline Backend getBackend()
+{
+    return Backend::NONE;
+}
+
+#else    // D3_DISABLE
+
+namespace detail
+{
+/// The selected backend - use getBackend() and setBackend()
+extern std::atomic<Backend> g_backend;
+} // namespace detail
+
+/// @brief   Select the backend
+/// @param   backend The backend to use from here on
+///
+/// The initial backend is read from the D3_BACKEND environment variable
+/// ("display", "none" or "stats"), so a deployed binary can be quieted without
+/// a rebuild. Set the backend before the first add - once the window is up
+/// switching away from DISPLAY just stops further adds from reaching it.
+void setBackend(const Backend& backend);
+
+/// @brief   The selected backend
+/// @note    This is a single relaxed atomic load, cheap enough to guard every
+///          call into the display interface
+inline Backend getBackend()
+{
+    return detail::g_backend.load(std::memory_order_relaxed);
+}
+
+#endif   // D3_DISABLE
+
+} // namespace d3
@@ -0,0 +1,234 @@
+/////////////////////////////////////////////////////////////////
+/// @file      CommandQueue.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Bounded lock-free queue feeding the display thread
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace d3
+{
+
+/// @brief   What a producer should do when the command queue is full
+///
+/// Only the commands marked droppable (plain node adds) are ever thrown away -
+/// anything else waits for room whatever the policy.
+enum class QueuePolicy
+{
+    BLOCK = 0,   ///< Wait (yielding) until the display thread makes room
+    DROP_OLDEST, ///< Throw away the oldest queued command to make room
+    DROP_NEWEST  ///< Throw away the command being pushed
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Bounded, lock-free, multi-producer queue drained by the display
+///          thread
+///
+/// This is the well known bounded array queue where each cell carries a
+/// sequence number telling producers and consumers whether the cell is free or
+/// full for their current lap around the ring. A push is a single
+/// compare-and-swap in the uncontended case and never takes a lock, so
+/// algorithm threads are never held up by a frame being rendered.
+///
+/// Only the display thread consumes, but a producer under DROP_OLDEST takes the
+/// oldest command off the front when it may be dropped. The pops are serialized
+/// by a flag so the producer can look at the front before it takes it - the
+/// order of what is left is never changed.
+///
+/// T has a public boolean droppable member - only those that are true are
+/// thrown away by the policies.
+/////////////////////////////////////////////////////////////////
+template<typename T>
+class CommandQueue
+{
+  public:
+
+    /// @brief   Constructor
+    /// @param   capacity The number of commands the queue can hold (rounded up
+    ///          to the next power of two)
+    explicit CommandQueue(const size_t& capacity) :
+        m_cells(),
+        m_mask(0),
+        m_enqueuePos(0),
+        m_dequeuePos(0),
+        m_droppedOldest(0),
+        m_droppedNewest(0),
+        m_popping(false)
+    {
+        size_t size(2);
+        while ( size < capacity ) size <<= 1;
+
+        m_cells.reset(new Cell[size]);
+        m_mask = size - 1;
+        for ( size_t ii(0) ; ii<size ; ++ii )
+            m_cells[ii].sequence.store(ii, std::memory_order_relaxed);
+    };
+
+    /// @{
+    /// @name Noncopyable
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+    /// @}
+
+    /// @brief   Push a command onto the queue
+    /// @param   item The command to push (moved from on success)
+    /// @param   policy What to do if the queue is full
+    /// @return  boolean True if the item made it into the queue
+    bool push(T&& item, const QueuePolicy& policy)
+    {
+        while ( not tryPush(item) )
+        {
+            if ( (QueuePolicy::DROP_NEWEST == policy) && item.droppable )
+            {
+                m_droppedNewest.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // an oldest command that can't be dropped has to be run first
+            if ( (QueuePolicy::DROP_OLDEST != policy) || not dropOldest() )
+                std::this_thread::yield();
+        }
+        return true;
+    };
+
+    /// @brief   Single attempt to push
+    /// @param   item The item to move into the queue on success
+    /// @return  boolean False if the queue is full
+    bool tryPush(T& item)
+    {
+        Cell* cell(nullptr);
+        size_t pos( m_enqueuePos.load(std::memory_order_relaxed) );
+        while ( true )
+        {
+            cell = &m_cells[pos & m_mask];
+            const size_t seq( cell->sequence.load(std::memory_order_acquire) );
+            const intptr_t dif( static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) );
+            if ( 0 == dif )
+            {
+                if ( m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+                    break;
+            }
+            else if ( dif < 0 )
+            {
+                // full
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    };
+
+    /// @brief   Pop the oldest command off the queue
+    /// @param   item Where to move the command to
+    /// @return  boolean True if there was a command to pop
+    bool pop(T& item)
+    {
+        static const bool any(false);
+        return popFront(item, any);
+    };
+
+    /// @brief   The number of commands the queue can hold
+    size_t capacity() const { return m_mask + 1; };
+
+    /// @brief   The number of commands thrown away by DROP_OLDEST
+    uint64_t droppedOldest() const { return m_droppedOldest.load(std::memory_order_relaxed); };
+
+    /// @brief   The number of commands thrown away by DROP_NEWEST
+    uint64_t droppedNewest() const { return m_droppedNewest.load(std::memory_order_relaxed); };
+
+  private:
+
+    /// @brief   Throw away the oldest command, if it may be dropped
+    /// @return  boolean True if a command was thrown away
+    bool dropOldest()
+    {
+        static const bool onlyDroppable(true);
+        T oldest;
+        if ( not popFront(oldest, onlyDroppable) ) return false;
+
+        m_droppedOldest.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    /// @brief   Take the command off the front
+    /// @param   item Where to move the command to
+    /// @param   onlyDroppable Leave the command unless it is droppable
+    /// @return  boolean True if there was a command to take
+    bool popFront(T& item,
+                  const bool& onlyDroppable)
+    {
+        while ( m_popping.exchange(true, std::memory_order_acquire) )
+            std::this_thread::yield();
+
+        const size_t pos( m_dequeuePos.load(std::memory_order_relaxed) );
+        Cell& cell( m_cells[pos & m_mask] );
+        const bool full( cell.sequence.load(std::memory_order_acquire) == pos + 1 );
+        const bool take( full && (not onlyDroppable || cell.data.droppable) );
+        if ( take )
+        {
+            // take the data and release whatever the cell was holding on to
+            m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+            item = std::move(cell.data);
+            cell.data = T();
+            cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+        }
+
+        m_popping.store(false, std::memory_order_release);
+        return take;
+    };
+
+    /// One slot in the ring
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T                   data;
+    };
+
+    /// The ring itself
+    std::unique_ptr<Cell[]>       m_cells;
+
+    /// capacity - 1 (capacity is a power of two)
+    size_t                        m_mask;
+
+    /// Keep the producer and consumer positions on their own cache lines
+    char                          m_pad0[64];
+
+    /// Where the next push goes
+    std::atomic<size_t>           m_enqueuePos;
+
+    /// Keep the producer and consumer positions on their own cache lines
+    char                          m_pad1[64];
+
+    /// Where the next pop comes from
+    std::atomic<size_t>           m_dequeuePos;
+
+    /// Keep the counters off the consumer's cache line
+    char                          m_pad2[64];
+
+    /// Number of commands discarded by DROP_OLDEST
+    std::atomic<uint64_t>         m_droppedOldest;
+
+    /// Number of commands discarded by DROP_NEWEST
+    std::atomic<uint64_t>         m_droppedNewest;
+
+    /// Set while a command is being taken off the front
+    std::atomic<bool>             m_popping;
+};
+
+} // namespace d3
@@ -10,14 +10,188 @@
 #include "DisplayInterface.h"
 #include "MainWindow.h"
 #include "QOSGWidget.h"
+#include "ThreadPool.h"
 #include "TreeView.h"
 
+#include <DDDisplayObjects/Memory.h>
+
+#include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <cstring>
 
 namespace d3
 {
 
+namespace detail
+{
+/// The state behind a Handle
+struct HandleEntry
+{
+    /// The name
+    std::string       name;
+
+    /// The tree entry of the name once it has been added (only touched on the
+    /// display thread)
+    TreeModel::Entry* pItem;
+
+    /// The tree view generation pItem was found in - a removal since may
+    /// have deleted it
+    uint64_t          generation;
+};
+} // namespace detail
+
+namespace
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The result of an addAsync(), set however the add ends
+///
+/// The pool task and the display command share it. When both are thrown away
+/// without setting it - the command evicted by DROP_OLDEST, the task dropped
+/// by the pool shutting down - the last one out sets it false, so the caller's
+/// future never breaks.
+/////////////////////////////////////////////////////////////////
+class Outcome
+{
+  public:
+
+    /// @brief   Constructor
+    Outcome() :
+        m_promise(),
+        m_set(false)
+    {
+    };
+
+    /// @brief   Destructor - false unless set already
+    ~Outcome()
+    {
+        set(false);
+    };
+
+    /// @brief   The future of the result
+    std::future<bool> future() { return m_promise.get_future(); };
+
+    /// @brief   Set the result (only the first one counts)
+    void set(const bool& value)
+    {
+        if ( not m_set.exchange(true) ) m_promise.set_value(value);
+    };
+
+  private:
+
+    /// The result
+    std::promise<bool> m_promise;
+
+    /// Set once the result is
+    std::atomic<bool>  m_set;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The result of a flush(), set however the fence ends
+///
+/// A fence is never dropped by the queue policy, but one thrown away unrun
+/// (the display going away with commands still queued) still releases the
+/// caller rather than breaking their future.
+/////////////////////////////////////////////////////////////////
+class Fence
+{
+  public:
+
+    /// @brief   Constructor
+    Fence() :
+        m_promise(),
+        m_set(false)
+    {
+    };
+
+    /// @brief   Destructor - set unless set already
+    ~Fence()
+    {
+        set();
+    };
+
+    /// @brief   The future of the fence
+    std::future<void> future() { return m_promise.get_future(); };
+
+    /// @brief   Set the fence (only the first one counts)
+    void set()
+    {
+        if ( not m_set.exchange(true) ) m_promise.set_value();
+    };
+
+  private:
+
+    /// The fence
+    std::promise<void> m_promise;
+
+    /// Set once the fence is
+    std::atomic<bool>  m_set;
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Drains the display interface on the display thread
+///
+/// Producers post a wake event to this object and the qt event loop hands it
+/// over on the display thread. The timer brings us back when the osg lock is
+/// held by someone else or a rate limited update comes due.
+/////////////////////////////////////////////////////////////////
+class CommandPump : public QObject
+{
+  public:
+
+    /// @brief   Constructor
+    /// @param   pDI The display interface to drain
+    explicit CommandPump(DisplayInterface* pDI) :
+        QObject(),
+        m_pDI(pDI),
+        m_timerId(0)
+    {
+    };
+
+    /// @brief   The type of the wake event
+    static QEvent::Type wakeType()
+    {
+        static const QEvent::Type type( static_cast<QEvent::Type>(QEvent::registerEventType()) );
+        return type;
+    };
+
+    /// @brief   Drain again after a while
+    /// @param   delay How long to wait
+    void drainIn(const std::chrono::steady_clock::duration& delay)
+    {
+        if ( 0 != m_timerId ) killTimer(m_timerId);
+        const auto ms( std::chrono::duration_cast<std::chrono::milliseconds>(delay).count() + 1 );
+        m_timerId = startTimer(static_cast<int>(std::min<decltype(ms)>(ms, 1000)));
+    };
+
+  protected:
+
+    /// @brief   A wake from a producer
+    virtual void customEvent(QEvent* theEvent)
+    {
+        if ( wakeType() == theEvent->type() ) m_pDI->drain();
+    };
+
+    /// @brief   A scheduled drain
+    virtual void timerEvent(QTimerEvent* theEvent)
+    {
+        killTimer(theEvent->timerId());
+        m_timerId = 0;
+        m_pDI->drain();
+    };
+
+  private:
+
+    /// The display interface to drain
+    DisplayInterface* m_pDI;
+
+    /// The pending drainIn() timer (0 if none)
+    int               m_timerId;
+};
+
 DisplayInterface& di()
 {
     // forward to the singleton getter
@@ -44,55 +218,380 @@ std::shared_ptr<DisplayInterface> DisplayInterface::get()
     return pInstance;
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+DisplayInterface::Batch::Batch(DisplayInterface* pDI) :
+    m_pDI(pDI),
+    m_entries()
+{
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+DisplayInterface::Batch::Batch(Batch&& other) :
+    m_pDI(other.m_pDI),
+    m_entries(std::move(other.m_entries))
+{
+    other.m_pDI = nullptr;
+    other.m_entries.clear();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+DisplayInterface::Batch::~Batch()
+{
+    commit();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::Batch::add(const std::string& name,
+                                  const osg::ref_ptr<osg::Node>& node,
+                                  const bool& replace /* = true */)
+{
+    if ( Backend::DISPLAY != getBackend() )
+    {
+        m_pDI->record(name, node.get());
+        return;
+    }
+
+    m_entries.push_back(Entry{name, node, replace});
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::Batch::commit()
+{
+    if ( (nullptr == m_pDI) || m_entries.empty() ) return true;
+
+    // the command has to be copyable, so share the entries with it
+    std::shared_ptr<std::vector<Entry>> entries( std::make_shared<std::vector<Entry>>() );
+    entries->swap(m_entries);
+
+    for ( const Entry& entry : *entries )
+    {
+        m_pDI->flushUpdate(entry.name);
+        m_pDI->supersede(entry.name);
+    }
+
+    DisplayInterface* pDI( m_pDI );
+    static const bool droppable(true);
+    return m_pDI->enqueue([pDI, entries]() { pDI->applyBatch(*entries); }, droppable);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+DisplayInterface::Batch DisplayInterface::beginBatch()
+{
+    return Batch(this);
+};
+
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 bool DisplayInterface::add(const std::string& name,
-                           const osg::ref_ptr<osg::Node> node,
+                           const osg::ref_ptr<osg::Node>& node,
                            const bool& replace /* = true */)
 {
-    // we have data - the display thread needs to know this before we setup the
-    // main window
-    m_haveData = true;
+    if ( Backend::DISPLAY != getBackend() ) return record(name, node.get());
+
+    // hand the add to the display thread
+    // @note: the setupMainWindow() also sets up the tree view.
+    flushUpdate(name);
+    supersede(name);
+    static const bool droppable(true);
+    return enqueue([this, name, node, replace]()
+                   {
+                       static const bool showNode(true);
+                       m_pTreeView->add(name, node, showNode, replace);
+                   }, droppable);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::add(const std::string& name,
+                           const osg::ref_ptr<osg::Node>& node,
+                           const TimeToLive& ttl,
+                           const bool& replace /* = true */)
+{
+    if ( Backend::DISPLAY != getBackend() ) return record(name, node.get());
+
+    flushUpdate(name);
+    supersede(name);
+    static const bool droppable(true);
+    return enqueue([this, name, node, ttl, replace]()
+                   {
+                       static const bool showNode(true);
+                       m_pTreeView->add(name, node, showNode, replace, ttl);
+                   }, droppable);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::add(const std::string& name,
+                           const osg::ref_ptr<osg::Node>& node,
+                           const Append::Window& window)
+{
+    if ( Backend::DISPLAY != getBackend() ) return record(name, node.get());
+
+    flushUpdate(name);
+    supersede(name);
+    static const bool droppable(true);
+    return enqueue([this, name, node, window]()
+                   {
+                       static const bool showNode(true);
+                       m_pTreeView->add(name, node, showNode, window);
+                   }, droppable);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+Handle DisplayInterface::handle(const std::string& name)
+{
+    return intern(detail::pathHash(name.c_str()), name.c_str());
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+Handle DisplayInterface::handle(const Path& path)
+{
+    return intern(path.hash(), path.name());
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::add(const Handle& handle,
+                           const osg::ref_ptr<osg::Node>& node,
+                           const bool& replace /* = true */)
+{
+    if ( not handle.valid() ) return false;
+    if ( Backend::DISPLAY != getBackend() ) return record(handle.m_pEntry->name, node.get());
+
+    flushUpdate(handle.m_pEntry->name);
+    supersede(handle.m_pEntry->name);
+    return enqueue(QueueEntry(handle.m_pEntry, node, replace));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::update(const std::string& name,
+                              const osg::ref_ptr<osg::Node>& node)
+{
+    if ( Backend::DISPLAY != getBackend() ) return record(name, node.get());
+    if ( not prepareAdd() ) return false;
+    supersede(name);
 
-    // make sure the main window has been setup
-    if ( not setupMainWindow() )
     {
-        std::cerr << "BUMMER: No main window for you" << std::endl;
-        m_haveData = false;
-        return false;
+        std::lock_guard<std::mutex> l_lock(m_slotMutex);
+        UpdateSlots_t::value_type& entry( *m_updateSlots.emplace(name, UpdateSlot{nullptr, false, 1, 0, {}, {}}).first );
+        UpdateSlot& slot( entry.second );
+
+        // decimate
+        if ( ++slot.count < slot.decimation ) return false;
+        slot.count = 0;
+
+        // overwrite whatever is pending, and note the slot is dirty if it wasn't
+        if ( not slot.dirty )
+        {
+            slot.dirty = true;
+            m_dirtySlots.push_back(&entry);
+            m_numDirty = m_dirtySlots.size();
+        }
+        slot.pending = node;
     }
 
-    // get the lock so we can add stuff
-    std::lock_guard<std::mutex> l_lock(m_mutex);
+    wake();
+    return true;
+};
 
-    // add this node to the tree view
-    // @note: the setupMainWindow() also sets up the tree view.
-    static const bool showNode(true);
-    return m_pTreeView->add(name, node, showNode, replace);
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::setUpdateLimit(const std::string& name,
+                                      const double& maxRate,
+                                      const unsigned int& decimation /* = 1 */)
+{
+    std::lock_guard<std::mutex> l_lock(m_slotMutex);
+    UpdateSlot& slot( m_updateSlots.emplace(name, UpdateSlot{nullptr, false, 1, 0, {}, {}}).first->second );
+
+    slot.decimation = std::max(1u, decimation);
+    slot.count = 0;
+    if ( maxRate > 0.0 )
+        slot.minPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>
+            (std::chrono::duration<double>(1.0/maxRate));
+    else
+        slot.minPeriod = std::chrono::steady_clock::duration::zero();
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-bool DisplayInterface::add(const osgGA::GUIEventAdapter::KeySymbol& key,
-                           const std::function<bool(const osgGA::GUIEventAdapter&)>& func,
-                           const std::string& description /* = "NONE" */)
+bool DisplayInterface::addSwapBuffer(const std::string& name,
+                                     const osg::ref_ptr<SwapBufferBase>& buffer)
 {
-    // we have data - the display thread needs to know this before we setup the
-    // main window
-    m_haveData = true;
+    flushUpdate(name);
+    supersede(name);
+    return enqueue([this, name, buffer]()
+                   {
+                       static const bool showNode(true);
+                       static const bool replace(true);
+                       if ( m_pTreeView->add(name, buffer->getGroup(), showNode, replace) )
+                           m_pOsgWidget->addSwapBuffer(buffer);
+                   });
+};
 
-    // make sure the main window has been setup
-    if ( not setupMainWindow() )
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::future<bool> DisplayInterface::addBuilt(const std::string& name,
+                                             Builder_t&& builder)
+{
+    std::call_once(m_poolOnce, [this]() { m_pPool.reset(new ThreadPool()); });
+
+    // the result is shared by the pool task and the display command
+    std::shared_ptr<Outcome> done( std::make_shared<Outcome>() );
+    std::future<bool> result( done->future() );
+    std::shared_ptr<Builder_t> pBuilder( std::make_shared<Builder_t>(std::move(builder)) );
+
+    // builds finish in any order - only the newest of the name goes in
+    const uint64_t ticket( startBuild(name) );
+
+    m_pPool->submit([this, name, pBuilder, done, ticket]()
+                    {
+                        // nothing may escape a pool thread
+                        osg::ref_ptr<osg::Node> node;
+                        try
+                        {
+                            node = (*pBuilder)();
+                        }
+                        catch ( const std::exception& e )
+                        {
+                            std::cerr << "BUMMER: Could not build " << name << ": " << e.what() << std::endl;
+                        }
+                        catch ( ... )
+                        {
+                            std::cerr << "BUMMER: Could not build " << name << std::endl;
+                        }
+                        *pBuilder = nullptr;
+
+                        if ( not node )
+                        {
+                            finishBuild(name, ticket);
+                            done->set(false);
+                            return;
+                        }
+
+                        // only the size of the node is wanted
+                        if ( Backend::STATS == getBackend() )
+                        {
+                            finishBuild(name, ticket);
+                            done->set(record(name, node.get()));
+                            return;
+                        }
+
+                        flushUpdate(name);
+                        static const bool droppable(true);
+                        const bool queued( enqueue([this, name, node, done, ticket]()
+                                                   {
+                                                       // something newer was given while this built
+                                                       if ( not finishBuild(name, ticket) )
+                                                       {
+                                                           done->set(false);
+                                                           return;
+                                                       }
+
+                                                       static const bool showNode(true);
+                                                       static const bool replace(true);
+                                                       done->set(m_pTreeView->add(name, node, showNode, replace));
+                                                   }, droppable) );
+                        if ( not queued )
+                        {
+                            finishBuild(name, ticket);
+                            done->set(false);
+                        }
+                    });
+    return result;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::addShared(const std::string& name,
+                                 const uint64_t& key,
+                                 const Builder_t& builder)
+{
+    osg::ref_ptr<osg::Node> shared;
+    osg::ref_ptr<osg::Group> named;
     {
-        std::cerr << "BUMMER: No main window for you" << std::endl;
-        m_haveData = false;
-        return false;
+        std::lock_guard<std::mutex> l_lock(m_hashMutex);
+
+        // the name was last given this data
+        const auto last( m_hashedNames.find(name) );
+        if ( (m_hashedNames.end() != last) && (key == last->second.key) )
+            last->second.group.lock(named);
+
+        // another name may show it already
+        const auto found( m_sharedNodes.find(key) );
+        if ( not named && (m_sharedNodes.end() != found) ) found->second.lock(shared);
+    }
+
+    // a live group isn't necessarily in the tree (a history keeps replaced
+    // versions), so the display thread puts it back if anything else was added
+    // under the name since - nothing is built either way
+    if ( named )
+    {
+        if ( Backend::DISPLAY != getBackend() ) return true;
+
+        flushUpdate(name);
+        supersede(name);
+        static const bool droppable(true);
+        return enqueue([this, name, named]()
+                       {
+                           static const bool showNode(true);
+                           static const bool replace(true);
+                           if ( 0 == named->getNumParents() ) m_pTreeView->add(name, named, showNode, replace);
+                       }, droppable);
+    }
+
+    // building is the slow part, so it is done outside the lock
+    if ( not shared )
+    {
+        shared = builder();
+        if ( not shared ) return false;
+    }
+
+    // every name gets its own group over the shared node, so hiding one name
+    // doesn't hide the others
+    osg::ref_ptr<osg::Group> group( new osg::Group() );
+    group->addChild(shared);
+
+    {
+        std::lock_guard<std::mutex> l_lock(m_hashMutex);
+        m_sharedNodes[key] = shared;
+        m_hashedNames[name] = Hashed{key, group};
+
+        // forget the nodes nobody shows any more
+        if ( m_sharedNodes.size() >= m_sharedSweep )
+        {
+            for ( auto it(m_sharedNodes.begin()) ; it!=m_sharedNodes.end() ; )
+            {
+                if ( it->second.valid() ) ++it;
+                else                      it = m_sharedNodes.erase(it);
+            }
+            m_sharedSweep = std::max<size_t>(64, 2*m_sharedNodes.size());
+        }
     }
 
-    // get the lock so we can add stuff
-    std::lock_guard<std::mutex> l_lock(m_mutex);
+    return add(name, group);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::add(const osgGA::GUIEventAdapter::KeySymbol& key,
+                           const std::function<bool(const osgGA::GUIEventAdapter&)>& func,
+                           const std::string& description /* = "NONE" */)
+{
+    if ( Backend::DISPLAY != getBackend() ) return true;
 
-    return m_pOsgWidget->addKeyHandler(key, func, description);
+    return enqueue([this, key, func, description]()
+                   {
+                       m_pOsgWidget->addKeyHandler(key, func, description);
+                   });
 };
 
 /////////////////////////////////////////////////////////////////
@@ -110,19 +609,12 @@ bool DisplayInterface::add(const osgGA::GUIEventAdapter::MouseButtonMask& button
                            const std::function<bool(const osgGA::GUIEventAdapter&)>& func,
                            const std::string& description /* = "NONE" */)
 {
-    m_haveData = true;
-
-    if ( not setupMainWindow() )
-    {
-        std::cerr << "BUMMER: No main window for you" << std::endl;
-        m_haveData = false;
-        return false;
-    }
+    if ( Backend::DISPLAY != getBackend() ) return true;
 
-    // get the lock so we can add stuff
-    std::lock_guard<std::mutex> l_lock(m_mutex);
-
-    return m_pOsgWidget->addClickHandler(button, func, description);
+    return enqueue([this, button, func, description]()
+                   {
+                       m_pOsgWidget->addClickHandler(button, func, description);
+                   });
 };
 
 /////////////////////////////////////////////////////////////////
@@ -130,19 +622,12 @@ bool DisplayInterface::add(const osgGA::GUIEventAdapter::MouseButtonMask& button
 bool DisplayInterface::add(const std::function<bool(const osgGA::GUIEventAdapter&)>& func,
                            const std::string& description /* = "NONE" */)
 {
-    m_haveData = true;
-
-    if ( not setupMainWindow() )
-    {
-        std::cerr << "BUMMER: No main window for you" << std::endl;
-        m_haveData = false;
-        return false;
-    }
-
-    // get the lock so we can add stuff
-    std::lock_guard<std::mutex> l_lock(m_mutex);
+    if ( Backend::DISPLAY != getBackend() ) return true;
 
-    return m_pOsgWidget->addMotionEventHandler(func, description);
+    return enqueue([this, func, description]()
+                   {
+                       m_pOsgWidget->addMotionEventHandler(func, description);
+                   });
 };
 
 /////////////////////////////////////////////////////////////////
@@ -152,6 +637,8 @@ bool DisplayInterface::track(const osg::ref_ptr<osg::Node>& node,
                              const osg::Vec3d center /* = osg::Vec3d{0.0, 0.0, 0.0} */,
                              const osg::Vec3d up /* = osg::Vec3d{0.0, 0.0, 1.0}*/ )
 {
+    if ( Backend::DISPLAY != getBackend() ) return true;
+
     // we have data - the display thread needs to know this before we setup the
     // main window
     m_haveData = true;
@@ -173,68 +660,255 @@ bool DisplayInterface::track(const osg::ref_ptr<osg::Node>& node,
 void DisplayInterface::blockForClose()
 {
     // notify that we are waiting for the drawing to close
-    if ( m_haveData && m_pMainWindow && m_pMainWindow->isVisible() )
+    if ( m_windowOpen )
     {
         std::cout << "Waiting for window to close" << std::endl;
 
-        // while stuff is still running
-        while ( m_haveData && m_pMainWindow && m_pMainWindow->isVisible() )
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        std::unique_lock<std::mutex> l_lock(m_closeMutex);
+        m_closeNotify.wait(l_lock, [this]() { return not m_windowOpen; });
     }
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-bool DisplayInterface::running() const
+bool DisplayInterface::waitForClose(const std::chrono::milliseconds& timeout)
 {
-    return (m_pMainWindow && m_pMainWindow->isVisible());
+    std::unique_lock<std::mutex> l_lock(m_closeMutex);
+    return m_closeNotify.wait_for(l_lock, timeout, [this]() { return not m_windowOpen; });
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-bool DisplayInterface::lock()
+void DisplayInterface::onClose(const std::function<void()>& callback)
 {
-    // make sure the main window has been setup
-    if ( not setupMainWindow() )
     {
-        std::cerr << "BUMMER: No main window for you" << std::endl;
-        m_haveData = false;
-        return false;
+        std::lock_guard<std::mutex> l_lock(m_closeMutex);
+
+        // still to come (or the window isn't up yet)
+        if ( m_windowOpen || not m_setupComplete )
+        {
+            m_closeCallbacks.push_back(callback);
+            return;
+        }
     }
 
-    m_pOsgWidget->lock();
-    return true;
+    // already closed
+    callback();
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-bool DisplayInterface::try_lock()
+bool DisplayInterface::setVisible(const std::string& pattern,
+                                  const bool& visible)
 {
-    if ( m_pOsgWidget )
-        return m_pOsgWidget->try_lock();
-    return false;
+    // nothing is shown yet, so there is nothing to change - don't start the
+    // display just for that
+    if ( (Backend::DISPLAY != getBackend()) || not m_haveData ) return true;
+
+    return enqueue([this, pattern, visible]() { m_pTreeView->setVisible(pattern, visible); });
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-bool DisplayInterface::unlock()
+bool DisplayInterface::remove(const std::string& name)
 {
-    if ( m_pOsgWidget )
-    {
-        m_pOsgWidget->unlock();
-        return true;
-    }
-    return false;
+    if ( Backend::DISPLAY != getBackend() ) return true;
+
+    static const bool whole(true);
+    dropUpdates(name, whole);
+
+    // nothing is shown yet - don't start the display just to remove nothing
+    if ( not m_haveData ) return true;
+
+    return enqueue([this, name]() { m_pTreeView->remove(name); });
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-osg::ref_ptr<osg::Group> DisplayInterface::getRootGroup() const
+bool DisplayInterface::clear(const std::string& prefix /* = "" */)
 {
-    if ( m_pOsgWidget )
-        return m_pOsgWidget->getRootGroup();
+    if ( Backend::DISPLAY != getBackend() ) return true;
 
-    return nullptr;
+    static const bool whole(false);
+    dropUpdates(prefix, whole);
+
+    // nothing is shown yet - don't start the display just to remove nothing
+    if ( not m_haveData ) return true;
+
+    return enqueue([this, prefix]() { m_pTreeView->clear(prefix); });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::setHistory(const std::string& name,
+                                  const size_t& versions)
+{
+    if ( Backend::DISPLAY != getBackend() ) return true;
+
+    return configure([this, name, versions]() { m_pTreeView->setHistory(name, versions); });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::setHistoryBudget(const size_t& bytes)
+{
+    if ( Backend::DISPLAY != getBackend() ) return true;
+
+    return configure([this, bytes]() { m_pTreeView->setHistoryBudget(bytes); });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::setOnDemandRendering(const bool& onDemand)
+{
+    if ( Backend::DISPLAY != getBackend() ) return true;
+
+    return configure([this, onDemand]()
+                   {
+                       m_pMainWindow->setRenderMode(onDemand ?
+                                                    MainWindow::RenderMode::ON_DEMAND :
+                                                    MainWindow::RenderMode::CONTINUOUS);
+                   });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::setMaxFrameRate(const double& fps)
+{
+    if ( Backend::DISPLAY != getBackend() ) return true;
+
+    return configure([this, fps]() { m_pMainWindow->setMaxFrameRate(fps); });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::requestRedraw()
+{
+    if ( m_pOsgWidget ) m_pOsgWidget->requestRedraw();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::future<void> DisplayInterface::flush()
+{
+    // flush() is called to wait on the display - don't start it just for that
+    if ( (Backend::DISPLAY != getBackend()) || not m_haveData )
+    {
+        std::promise<void> promise;
+        promise.set_value();
+        return promise.get_future();
+    }
+
+    std::shared_ptr<Fence> done( std::make_shared<Fence>() );
+    std::future<void> result( done->future() );
+
+    // commands run in order, so once this one has run so have the others
+    if ( not enqueue([done]() { done->set(); }) )
+        done->set();
+    return result;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+DisplayInterface::Stats_t DisplayInterface::getStats() const
+{
+    std::lock_guard<std::mutex> l_lock(m_statsMutex);
+    return m_stats;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::resetStats()
+{
+    std::lock_guard<std::mutex> l_lock(m_statsMutex);
+    m_stats.clear();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::running() const
+{
+    return m_windowOpen;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::setQueuePolicy(const QueuePolicy& policy)
+{
+    m_queuePolicy = policy;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+QueuePolicy DisplayInterface::getQueuePolicy() const
+{
+    return m_queuePolicy;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+uint64_t DisplayInterface::getDroppedOldest() const
+{
+    return m_commands.droppedOldest();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+uint64_t DisplayInterface::getDroppedNewest() const
+{
+    return m_commands.droppedNewest();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::lock()
+{
+    // nothing to lock
+    if ( Backend::DISPLAY != getBackend() ) return false;
+
+    // make sure the main window has been setup
+    if ( not setupMainWindow() )
+    {
+        std::cerr << "BUMMER: No main window for you" << std::endl;
+        m_haveData = false;
+        return false;
+    }
+
+    m_pOsgWidget->lock();
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::try_lock()
+{
+    if ( m_pOsgWidget )
+        return m_pOsgWidget->try_lock();
+    return false;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::unlock()
+{
+    if ( m_pOsgWidget )
+    {
+        // whatever was done under the lock needs to be drawn
+        m_pOsgWidget->requestRedraw();
+        m_pOsgWidget->unlock();
+        return true;
+    }
+    return false;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Group> DisplayInterface::getRootGroup() const
+{
+    if ( m_pOsgWidget )
+        return m_pOsgWidget->getRootGroup();
+
+    return nullptr;
 };
 
 /////////////////////////////////////////////////////////////////
@@ -264,120 +938,67 @@ DisplayInterface::DisplayInterface() :
     m_addNotify(),
     m_haveData(false),
     m_setupComplete(false),
+    m_settings(),
     m_displayThread(),
-    m_threadShouldRun(true)
-{
-    m_displayThread =
-        std::thread
-        ([&]()
-         {
-             m_setupComplete = false;
-
-             // Create the pointer to the main application
-             QApplication* application(nullptr);
-
-             {
-                 // get the lock
-                 std::unique_lock<std::mutex> l_lock(m_mutex);
-
-                 // wait for data to be added
-                 while ( not m_haveData )
-                     m_addNotify.wait(l_lock);
-
-                 if ( not m_threadShouldRun )
-                     return;
-
-                 // faked command line args for qt
-                 int argc = 1;
-                 std::string arg0 = "DisplayInterface";
-                 char *argv[1];
-                 argv[0] = const_cast<char *>(arg0.c_str());
-
-                 // create the QApplication
-                 application = new QApplication(argc, argv);
-
-                 // create the new main window
-                 if ( nullptr == m_pMainWindow )
-                 {
-                     m_pMainWindow = new MainWindow();
-                     m_pMainWindow->setMinimumSize(1024, 768);
-                     m_pMainWindow->setSizePolicy(QSizePolicy::MinimumExpanding,
-                                                  QSizePolicy::MinimumExpanding);
-                 }
-
-                 // create the osg widget
-                 if ( nullptr == m_pOsgWidget )
-                 {
-                     m_pOsgWidget = new QOSGWidget();
-                     m_pOsgWidget->initialize();
-                 }
-
-                 // pack the osg widget into the main window
-                 m_pMainWindow->setOsgWidget(m_pOsgWidget);
-
-                 // setup the m_pTree veiw for all the objets
-                 if ( nullptr == m_pTreeView )
-                 {
-                     m_pTreeView = new TreeView();
-                     m_pTreeView->setOsgWidget(m_pOsgWidget);
-                 }
-
-                 // pack this tree view into the main window
-                 m_pMainWindow->setTreeView(m_pTreeView);
-                 
-             }
-
-             // set the setup complete flag
-             m_setupComplete = true;
-
-             // notify the add method that we are done setting up the main window
-             m_addNotify.notify_all();
-
-             // run the application - forever
-             while ( m_threadShouldRun )
-             {
-                 // lock osg so qt doesn't clobber osg
-                 if ( m_pOsgWidget->try_lock() )
-                 {
-                     // lock the main window
-                     if ( m_pMainWindow->try_lock() )
-                     {
-                         application->processEvents();
-                         m_pMainWindow->unlock();
-                     }
-                     m_pOsgWidget->unlock();
-                 }
-
-                 // also sleep - we don't need to run full-bore even if there are not
-                 // other processes running
-                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
-             }
-         });
+    m_threadOnce(),
+    m_threadShouldRun(true),
+    m_pumpMutex(),
+    m_pPump(),
+    m_wakePending(false),
+    m_windowOpen(false),
+    m_displayThreadId(),
+    m_closeMutex(),
+    m_closeNotify(),
+    m_closeCallbacks(),
+    m_commands(4096),
+    m_queuePolicy(QueuePolicy::BLOCK),
+    m_slotMutex(),
+    m_updateSlots(),
+    m_dirtySlots(),
+    m_numDirty(0),
+    m_poolOnce(),
+    m_pPool(),
+    m_buildMutex(),
+    m_builds(),
+    m_buildTickets(0),
+    m_numBuilds(0),
+    m_handleMutex(),
+    m_handles(),
+    m_hashMutex(),
+    m_hashedNames(),
+    m_sharedNodes(),
+    m_sharedSweep(64),
+    m_statsMutex(),
+    m_stats()
+{
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 DisplayInterface::~DisplayInterface()
 {
-    // exit the qt appliation
-    QCoreApplication::exit(0);
+    // stop the builders before anything they would add to goes away
+    m_pPool.reset();
 
-    // see if we have been setup and need to close the main window
-    if ( nullptr != m_pMainWindow )
     {
-        // scoped lock
+        // scoped lock - coordinates with the setup in the display thread
         std::lock_guard<std::mutex> l_lock(m_mutex);
 
-        // close the window
-        if ( not m_pMainWindow->close() )
-            std::cerr << "BUMMER: Could not close the window" << std::endl;
+        // close the window and leave the event loop, both on the display
+        // thread and in that order
+        if ( nullptr != m_pMainWindow )
+            QMetaObject::invokeMethod(m_pMainWindow, "close", Qt::QueuedConnection);
+        if ( nullptr != QCoreApplication::instance() )
+            QMetaObject::invokeMethod(QCoreApplication::instance(), "quit", Qt::QueuedConnection);
+
+        m_haveData = true;
+        m_threadShouldRun = false;
     }
 
-    m_haveData = true;
-    m_threadShouldRun = false;
     if ( not m_setupComplete )
         m_addNotify.notify_all();
-    m_displayThread.join();
+    if ( m_displayThread.joinable() )
+        m_displayThread.join();
 };
 
 /////////////////////////////////////////////////////////////////
@@ -387,6 +1008,12 @@ bool DisplayInterface::setupMainWindow()
     // setup the main window if we need to
     if ( nullptr == m_pMainWindow )
     {
+        // the display thread is started by the first one through here
+        std::call_once(m_threadOnce, [this]()
+                       {
+                           m_displayThread = std::thread(&DisplayInterface::displayThreadLoop, this);
+                       });
+
         // get the lock and coordinate the setup with the display thread loop
         std::unique_lock<std::mutex> l_lock(m_mutex);
         m_addNotify.notify_all();
@@ -400,4 +1027,504 @@ bool DisplayInterface::setupMainWindow()
     return nullptr != m_pMainWindow;
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::displayThreadLoop()
+{
+    m_setupComplete = false;
+    m_displayThreadId = std::this_thread::get_id();
+
+    // Create the pointer to the main application
+    QApplication* application(nullptr);
+    bool runLoop(false);
+
+    {
+        // get the lock
+        std::unique_lock<std::mutex> l_lock(m_mutex);
+
+        // wait for data to be added
+        while ( not m_haveData )
+            m_addNotify.wait(l_lock);
+
+        if ( not m_threadShouldRun )
+            return;
+
+        // faked command line args for qt
+        int argc = 1;
+        std::string arg0 = "DisplayInterface";
+        char *argv[1];
+        argv[0] = const_cast<char *>(arg0.c_str());
+
+        // create the QApplication - it keeps running after the window
+        // is closed so adds are still drained until we go away
+        application = new QApplication(argc, argv);
+        application->setQuitOnLastWindowClosed(false);
+
+        // the receiver for the wakes from the producers
+        {
+            std::lock_guard<std::mutex> l_pumpLock(m_pumpMutex);
+            m_pPump.reset(new CommandPump(this));
+        }
+
+        // create the new main window
+        if ( nullptr == m_pMainWindow )
+        {
+            m_pMainWindow = new MainWindow();
+            m_pMainWindow->setMinimumSize(1024, 768);
+            m_pMainWindow->setSizePolicy(QSizePolicy::MinimumExpanding,
+                                         QSizePolicy::MinimumExpanding);
+        }
+
+        // create the osg widget
+        if ( nullptr == m_pOsgWidget )
+        {
+            m_pOsgWidget = new QOSGWidget();
+            m_pOsgWidget->initialize();
+        }
+
+        // pack the osg widget into the main window
+        m_pMainWindow->setOsgWidget(m_pOsgWidget);
+
+        // hear about the window closing the moment it happens
+        m_pMainWindow->setCloseCallback([this]() { windowClosed(); });
+
+        // setup the m_pTree veiw for all the objets
+        if ( nullptr == m_pTreeView )
+        {
+            m_pTreeView = new TreeView();
+            m_pTreeView->setOsgWidget(m_pOsgWidget);
+        }
+
+        // pack this tree view into the main window
+        m_pMainWindow->setTreeView(m_pTreeView);
+
+        // the settings given before there was a display - nothing has been
+        // queued yet, so they still go in ahead of every add
+        for ( const Command_t& setting : m_settings ) setting();
+        m_settings.clear();
+
+        // the destructor may have beaten us here
+        runLoop = m_threadShouldRun;
+
+        // set the setup complete flag
+        m_windowOpen = true;
+        m_setupComplete = true;
+    }
+
+    // notify the add method that we are done setting up the main window
+    m_addNotify.notify_all();
+
+    // anything added while we were setting up
+    wake();
+
+    // run the application - it sleeps until there is input, a frame
+    // to render or a wake, and returns when the destructor quits it
+    if ( runLoop )
+        application->exec();
+
+    // no producer is posting to the pump while it goes, and none will after
+    std::lock_guard<std::mutex> l_pumpLock(m_pumpMutex);
+    m_pPump.reset();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::prepareAdd()
+{
+    // nothing goes to the display unless it is the backend
+    if ( Backend::DISPLAY != getBackend() ) return false;
+
+    // we have data - the display thread needs to know this before we setup the
+    // main window
+    m_haveData = true;
+
+    // make sure the main window has been setup - this only waits the very
+    // first time through
+    if ( not setupMainWindow() )
+    {
+        std::cerr << "BUMMER: No main window for you" << std::endl;
+        m_haveData = false;
+        return false;
+    }
+
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::configure(Command_t&& setting)
+{
+    {
+        // coordinates with the setup in the display thread
+        std::lock_guard<std::mutex> l_lock(m_mutex);
+        if ( not m_setupComplete )
+        {
+            m_settings.push_back(std::move(setting));
+            return true;
+        }
+    }
+
+    return enqueue(std::move(setting));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::record(const std::string& name,
+                              const osg::Node* node)
+{
+    if ( Backend::STATS != getBackend() ) return true;
+
+    const size_t bytes( getByteSize(node) );
+    std::lock_guard<std::mutex> l_lock(m_statsMutex);
+    NameStats& stats( m_stats[name] );
+    ++stats.calls;
+    stats.bytes += bytes;
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::future<bool> DisplayInterface::ready(const bool& value)
+{
+    std::promise<bool> promise;
+    promise.set_value(value);
+    return promise.get_future();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::enqueue(Command_t&& command,
+                               const bool& droppable /* = false */)
+{
+    return enqueue(QueueEntry(std::move(command), droppable));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::enqueue(QueueEntry&& entry)
+{
+    if ( not prepareAdd() ) return false;
+
+    // waiting here would wait on ourselves - make room by running the oldest
+    if ( std::this_thread::get_id() == m_displayThreadId.load() )
+    {
+        if ( not m_commands.tryPush(entry) )
+        {
+            std::lock_guard<QOSGWidget> l_lock(*m_pOsgWidget);
+            QueueEntry oldest;
+            while ( not m_commands.tryPush(entry) )
+                if ( m_commands.pop(oldest) ) run(oldest);
+            m_pOsgWidget->requestRedraw();
+        }
+    }
+    else if ( not m_commands.push(std::move(entry), m_queuePolicy.load(std::memory_order_relaxed)) )
+    {
+        return false;
+    }
+
+    wake();
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::run(const QueueEntry& entry)
+{
+    if ( nullptr != entry.pHandle ) applyHandle(entry);
+    else                            entry.command();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+Handle DisplayInterface::intern(const uint64_t& hash,
+                                const char* name)
+{
+    std::lock_guard<std::mutex> l_lock(m_handleMutex);
+    std::unique_ptr<detail::HandleEntry>& pEntry( m_handles[hash] );
+    if ( not pEntry )
+    {
+        pEntry.reset(new detail::HandleEntry{name, nullptr, 0});
+    }
+    else if ( 0 != std::strcmp(pEntry->name.c_str(), name) )
+    {
+        std::cerr << "ERROR - the names " << pEntry->name << " and " << name
+                  << " have the same hash, no handle for the second" << std::endl;
+        return Handle();
+    }
+
+    return Handle(pEntry.get());
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::dropUpdates(const std::string& prefix,
+                                   const bool& whole)
+{
+    static const std::string splitIndicator("::");
+    auto dropped = [&](const std::string& name)
+        {
+            if ( 0 != name.compare(0, prefix.size(), prefix) ) return false;
+            return not whole || (name.size() == prefix.size()) ||
+                (0 == name.compare(prefix.size(), splitIndicator.size(), splitIndicator));
+        };
+
+    {
+        std::lock_guard<std::mutex> l_lock(m_slotMutex);
+        m_dirtySlots.erase(std::remove_if(m_dirtySlots.begin(), m_dirtySlots.end(),
+                                          [&](UpdateSlots_t::value_type* entry)
+                                          {
+                                              if ( not dropped(entry->first) ) return false;
+                                              entry->second.pending = nullptr;
+                                              entry->second.dirty = false;
+                                              return true;
+                                          }),
+                           m_dirtySlots.end());
+        m_numDirty = m_dirtySlots.size();
+    }
+
+    // a removed name has to be built again by the next addHashed()
+    {
+        std::lock_guard<std::mutex> l_hashLock(m_hashMutex);
+        for ( auto it(m_hashedNames.begin()) ; it!=m_hashedNames.end() ; )
+        {
+            if ( dropped(it->first) ) it = m_hashedNames.erase(it);
+            else                      ++it;
+        }
+    }
+
+    // and the addAsync() builds in flight don't bring it back
+    if ( 0 == m_numBuilds ) return;
+    std::lock_guard<std::mutex> l_buildLock(m_buildMutex);
+    for ( auto it(m_builds.begin()) ; it!=m_builds.end() ; )
+    {
+        if ( dropped(it->first) ) it = m_builds.erase(it);
+        else                      ++it;
+    }
+    m_numBuilds = m_builds.size();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::flushUpdate(const std::string& name)
+{
+    // nothing pending anywhere - the usual case costs no lock
+    if ( 0 == m_numDirty ) return;
+
+    osg::ref_ptr<osg::Node> pending;
+    {
+        std::lock_guard<std::mutex> l_lock(m_slotMutex);
+        const auto found( m_updateSlots.find(name) );
+        if ( (m_updateSlots.end() == found) || not found->second.dirty ) return;
+
+        UpdateSlot& slot( found->second );
+        pending = slot.pending;
+        slot.pending = nullptr;
+        slot.dirty = false;
+        slot.lastApplied = std::chrono::steady_clock::now();
+        m_dirtySlots.erase(std::find(m_dirtySlots.begin(), m_dirtySlots.end(), &*found));
+        m_numDirty = m_dirtySlots.size();
+    }
+
+    // the update was given first, so it goes in first
+    enqueue([this, name, pending]()
+            {
+                static const bool showNode(true);
+                static const bool replace(true);
+                m_pTreeView->add(name, pending, showNode, replace);
+            });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+uint64_t DisplayInterface::startBuild(const std::string& name)
+{
+    std::lock_guard<std::mutex> l_lock(m_buildMutex);
+    const uint64_t ticket( ++m_buildTickets );
+    m_builds[name] = ticket;
+    m_numBuilds = m_builds.size();
+    return ticket;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::supersede(const std::string& name)
+{
+    // nothing is being built - the usual case costs no lock
+    if ( 0 == m_numBuilds ) return;
+
+    std::lock_guard<std::mutex> l_lock(m_buildMutex);
+    m_builds.erase(name);
+    m_numBuilds = m_builds.size();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool DisplayInterface::finishBuild(const std::string& name,
+                                   const uint64_t& ticket)
+{
+    std::lock_guard<std::mutex> l_lock(m_buildMutex);
+    const auto found( m_builds.find(name) );
+    if ( (m_builds.end() == found) || (ticket != found->second) ) return false;
+
+    m_builds.erase(found);
+    m_numBuilds = m_builds.size();
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::applyHandle(const QueueEntry& entry)
+{
+    detail::HandleEntry& handle( *entry.pHandle );
+
+    // something was removed since the entry was found - look it up again
+    if ( m_pTreeView->generation() != handle.generation )
+    {
+        handle.pItem = m_pTreeView->find(handle.name);
+        handle.generation = m_pTreeView->generation();
+    }
+
+    // the first add goes by name, after that straight to the tree entry
+    if ( nullptr == handle.pItem )
+    {
+        static const bool showNode(true);
+        if ( m_pTreeView->add(handle.name, entry.node, showNode, entry.replace) )
+            handle.pItem = m_pTreeView->find(handle.name);
+        return;
+    }
+
+    m_pTreeView->add(handle.pItem, entry.node, entry.replace);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::windowClosed()
+{
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> l_lock(m_closeMutex);
+        if ( not m_windowOpen ) return;
+        m_windowOpen = false;
+        callbacks.swap(m_closeCallbacks);
+    }
+
+    // release the waiters first, then tell the listeners
+    m_closeNotify.notify_all();
+    for ( const auto& callback : callbacks )
+        callback();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::wake()
+{
+    // a wake is on its way already - the usual case costs no lock
+    if ( m_wakePending.load() ) return;
+
+    // only the first producer since the last drain posts the event
+    std::lock_guard<std::mutex> l_pumpLock(m_pumpMutex);
+    if ( m_pPump && not m_wakePending.exchange(true) )
+        QCoreApplication::postEvent(m_pPump.get(), new QEvent(CommandPump::wakeType()));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::drain()
+{
+    // anything pushed from here on needs (and gets) a new wake
+    m_wakePending = false;
+
+    // somebody is holding the display - come back shortly rather than stall
+    // the event loop waiting for them
+    if ( not m_pOsgWidget->try_lock() )
+    {
+        m_pPump->drainIn(std::chrono::milliseconds(1));
+        return;
+    }
+
+    const std::chrono::steady_clock::duration next( processCommands() );
+    m_pOsgWidget->unlock();
+
+    // a rate limited update is being held back
+    if ( std::chrono::steady_clock::duration::max() != next )
+        m_pPump->drainIn(next);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::chrono::steady_clock::duration DisplayInterface::processCommands()
+{
+    QueueEntry entry;
+    size_t count(0);
+    for ( ; count<m_commands.capacity() && m_commands.pop(entry) ; ++count )
+        run(entry);
+
+    // the scene changed
+    if ( 0 != count )
+        m_pOsgWidget->requestRedraw();
+
+    // there is more - let the waiting events in first
+    if ( m_commands.capacity() == count )
+        wake();
+
+    // and then the latest of each of the coalesced updates
+    return processUpdates();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::chrono::steady_clock::duration DisplayInterface::processUpdates()
+{
+    // take the due slots out from under the producers - the tree is only
+    // touched after the slot lock has been released
+    std::vector<std::pair<const std::string*, osg::ref_ptr<osg::Node>>> due;
+    std::chrono::steady_clock::duration next( std::chrono::steady_clock::duration::max() );
+    {
+        const auto now( std::chrono::steady_clock::now() );
+        std::lock_guard<std::mutex> l_lock(m_slotMutex);
+        if ( m_dirtySlots.empty() ) return next;
+
+        std::vector<UpdateSlots_t::value_type*> held;
+        due.reserve(m_dirtySlots.size());
+        for ( UpdateSlots_t::value_type* entry : m_dirtySlots )
+        {
+            UpdateSlot& slot( entry->second );
+            if ( now - slot.lastApplied < slot.minPeriod )
+            {
+                // rate limited - keep it pending for a later frame
+                held.push_back(entry);
+                next = std::min(next, slot.lastApplied + slot.minPeriod - now);
+                continue;
+            }
+            slot.lastApplied = now;
+            due.emplace_back(&entry->first, slot.pending);
+            slot.pending = nullptr;
+            slot.dirty = false;
+        }
+        m_dirtySlots.swap(held);
+        m_numDirty = m_dirtySlots.size();
+    }
+
+    static const bool showNode(true);
+    static const bool replace(true);
+    for ( const auto& update : due )
+        m_pTreeView->add(*update.first, update.second, showNode, replace);
+    if ( not due.empty() )
+        m_pOsgWidget->requestRedraw();
+
+    return next;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void DisplayInterface::applyBatch(const std::vector<Batch::Entry>& entries)
+{
+    // hold off the tree view layout until the whole batch is in
+    static const bool showNode(true);
+    m_pTreeView->beginUpdate();
+    for ( const Batch::Entry& entry : entries )
+        m_pTreeView->add(entry.name, entry.node, showNode, entry.replace);
+    m_pTreeView->endUpdate();
+};
+
 } // namespace d3
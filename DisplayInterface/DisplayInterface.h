@@ -9,14 +9,36 @@
 
 #pragma once
 
+#ifdef   D3_DISABLE
+#include <DDDisplayInterface/DisplayInterfaceStub.h>
+#else    // D3_DISABLE
+
 #include <DDDisplayInterface/MainPage.h>
+#include <DDDisplayInterface/Append.h>
+#include <DDDisplayInterface/Backend.h>
+#include <DDDisplayInterface/CommandQueue.h>
+#include <DDDisplayInterface/Path.h>
+#include <DDDisplayInterface/SwapBuffer.h>
+#include <DDDisplayInterface/TimeToLive.h>
+
+#include <DDDisplayObjects/Hash.h>
 
 #include <osg/Node>
+#include <osg/observer_ptr>
 #include <osgViewer/Viewer>
 
-#include <queue>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <queue>
 #include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
 
 class QWidget;
 class QDockWidget;
@@ -37,6 +59,40 @@ DisplayInterface& di();
 /// forward declare the stuff that makes life good
 class MainWindow;
 class QOSGWidget;
+class ThreadPool;
+class CommandPump;
+
+namespace detail
+{
+/// @brief   Build the node for one of the DisplayObjects types off the caller's
+///          thread (the right get() is found by argument dependent lookup)
+template<typename Data, typename... Args>
+osg::ref_ptr<osg::Node> buildNode(const std::shared_ptr<Data>& data, const Args&... args)
+{
+    return get(*data, args...);
+}
+
+/// @brief   Build the node for some data (inside DisplayInterface its own
+///          get() hides the d3::get() overloads)
+template<typename Data, typename... Args>
+osg::ref_ptr<osg::Node> build(const Data& data, const Args&... args)
+{
+    return get(data, args...);
+}
+
+/// @brief   Hash the extra arguments of a d3::get() into a seed
+inline uint64_t hashArgs(const uint64_t& seed)
+{
+    return seed;
+}
+
+/// @brief   Hash the extra arguments of a d3::get() into a seed
+template<typename Arg, typename... Args>
+uint64_t hashArgs(const uint64_t& seed, const Arg& arg, const Args&... args)
+{
+    return hashArgs(hash(arg, seed), args...);
+}
+} // namespace detail
 
 /// @brief   Class to instantiate a simple drawing window and add stuff to
 ///          it.
@@ -80,6 +136,24 @@ class QOSGWidget;
 /// }
 /// @endcode
 /// Thus enabling fast 3D display prototyping debugging and displaying
+///
+/// Building with -DD3_DISABLE compiles the whole thing out: calls wrapped in
+/// D3() vanish along with their arguments, and unwrapped ones go to the header
+/// only stubs in DisplayInterfaceStub.h - see DisplayObjects/Disable.h.
+///
+/// None of the add methods touch the display directly. Each one pushes a
+/// command onto a bounded lock-free queue which the display thread drains
+/// between frames, so a caller never waits on rendering. What happens when the
+/// queue is full is controlled with setQueuePolicy().
+///
+/// Nothing at all happens (no thread, no QApplication, no window) until the
+/// first add, and nothing ever happens if the backend is not
+/// Backend::DISPLAY - see setBackend().
+///
+/// The display thread sits in the qt event loop and sleeps until there is
+/// something to do - input, a frame to render, or a command. The first command
+/// pushed onto an empty queue posts a single wake event to the loop, the ones
+/// after that ride along with it.
 class DisplayInterface
 {
   public:
@@ -94,6 +168,93 @@ class DisplayInterface
     /// @note    Don't use this, use the di() global function interface
     static std::shared_ptr<DisplayInterface> get();
 
+    /////////////////////////////////////////////////////////////////
+    /// @brief   A group of adds applied to the display all at once
+    ///
+    /// Adding to a batch just collects the entries. On commit() (or when the
+    /// batch goes out of scope) the whole batch is handed to the display thread
+    /// as one command, so it is applied between two frames under one lock with
+    /// one tree view layout - a frame never shows half of it.
+    /// @code
+    /// auto batch( d3::di().beginBatch() );
+    /// for ( const auto& cell : frontier )
+    ///     batch.add( "frontier::" + cell.name, d3::get(cell.voxel) );
+    /// batch.commit();
+    /// @endcode
+    /////////////////////////////////////////////////////////////////
+    class Batch
+    {
+      public:
+
+        /// @brief   Move constructor (a batch is handed out by beginBatch())
+        Batch(Batch&& other);
+
+        /// @{
+        /// @name Noncopyable
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+        /// @}
+
+        /// @brief   Destructor - commits anything not yet committed
+        ~Batch();
+
+        /// @brief   Add a node to the batch
+        /// @param   name The name of the node (same convention as
+        ///          DisplayInterface::add())
+        /// @param   node The node to add
+        /// @param   replace Replace or append to an existing node with this
+        ///          name
+        void add(const std::string& name,
+                 const osg::ref_ptr<osg::Node>& node,
+                 const bool& replace = true);
+
+        /// @brief   Hand everything added so far to the display thread
+        /// @return  boolean True if the batch was queued
+        bool commit();
+
+        /// @brief   The number of entries waiting for commit()
+        size_t size() const { return m_entries.size(); };
+
+      private:
+
+        /// Only the display interface hands these out
+        friend class DisplayInterface;
+
+        /// @brief   Construct for a display interface
+        explicit Batch(DisplayInterface* pDI);
+
+        /// A single add in the batch
+        struct Entry
+        {
+            std::string             name;
+            osg::ref_ptr<osg::Node> node;
+            bool                    replace;
+        };
+
+        /// The display to commit to
+        DisplayInterface*           m_pDI;
+
+        /// The adds collected so far
+        std::vector<Entry>          m_entries;
+    };
+
+    /// What the STATS backend counted for a name
+    struct NameStats
+    {
+        /// The number of adds and updates
+        uint64_t calls;
+
+        /// The bytes of geometry in those adds and updates (see getByteSize())
+        uint64_t bytes;
+    };
+
+    /// The stats by name
+    typedef std::map<std::string, NameStats> Stats_t;
+
+    /// @brief   Start a batch of adds
+    /// @return  Batch The batch to add to and commit
+    Batch beginBatch();
+
     /// @brief   Method to add stuff to the display
     /// @param   name The name of the thing we are adding - a note on the naming
     ///          convention is below
@@ -101,7 +262,8 @@ class DisplayInterface
     /// @param   replace Should we replace the node if "name" already exists
     ///          (i.e. if false, it will just be appended to the current node
     ///          group)
-    /// @return  boolean True implies success
+    /// @return  boolean True implies the add was queued for the display thread
+    ///          (or was taken care of by the NONE or STATS backend)
     ///
     /// This is the main method used to add an osg node to the display by
     /// name. The name of the item will be added to the tree view on the right
@@ -140,14 +302,224 @@ class DisplayInterface
     /// organizing displays and turning things on and off to view only what is
     /// desired.
     bool add(const std::string& name,
-             const osg::ref_ptr<osg::Node> node,
+             const osg::ref_ptr<osg::Node>& node,
+             const bool& replace = true);
+
+    /// @brief   Add something that takes itself out of the display again
+    /// @param   name The name (same convention as add())
+    /// @param   node The osg node we are adding
+    /// @param   ttl How long the node stays (see TimeToLive)
+    /// @param   replace Replace the node or append to it (as in add())
+    /// @return  boolean True implies the add was queued for the display thread
+    ///
+    /// The display thread keeps the live nodes in a min-heap per unit and takes
+    /// each out once its time is up, so fire-and-forget debug drawing stays
+    /// bounded without the producer tracking it. Only this node expires - when
+    /// appending, the other nodes of the name stay, and a name left with
+    /// nothing is removed from the tree. A node replaced before it expires is
+    /// simply gone already.
+    bool add(const std::string& name,
+             const osg::ref_ptr<osg::Node>& node,
+             const TimeToLive& ttl,
+             const bool& replace = true);
+
+    /// @brief   Append to a name, keeping only the most recent appends
+    /// @param   name The name (same convention as add())
+    /// @param   node The osg node we are appending
+    /// @param   window How many appends, or how many seconds of them, to keep
+    /// @return  boolean True implies the add was queued for the display thread
+    ///
+    /// The name's appends are a ring - the oldest is evicted in constant time
+    /// when a new one pushes it out of the window, and a window in seconds is
+    /// aged every frame without any further adds. Odometry trails and scan
+    /// histories stay bounded however long the session runs.
+    /// @code
+    /// d3::di().add( "odometry::trail", d3::get(d3::Triad{pose}), d3::Append::Window{500} );
+    /// @endcode
+    bool add(const std::string& name,
+             const osg::ref_ptr<osg::Node>& node,
+             const Append::Window& window);
+
+    /// @brief   Resolve a name once for adds in a tight loop
+    /// @param   name The name (same convention as add())
+    /// @return  Handle The handle to add to
+    ///
+    /// The name is split and looked up in the tree only by the first add to the
+    /// handle, every add after that is a direct replace (or append) of the
+    /// tree entry.
+    /// @code
+    /// const d3::Handle track( d3::di().handle("tracks::" + id) );
+    /// for ( const auto& state : states )
+    ///     d3::di().add( track, d3::get(state) );
+    /// @endcode
+    Handle handle(const std::string& name);
+
+    /// @brief   Resolve a name hashed at compile time
+    /// @param   path The name
+    /// @return  Handle The handle to add to
+    Handle handle(const Path& path);
+
+    /// @brief   Add to a handle
+    /// @param   handle The handle from handle()
+    /// @param   node The osg node we are adding
+    /// @param   replace Replace the node or append to it (as in add())
+    /// @return  boolean True implies the add was queued for the display thread
+    bool add(const Handle& handle,
+             const osg::ref_ptr<osg::Node>& node,
              const bool& replace = true);
 
+    /// @brief   Add to a name hashed at compile time
+    /// @param   path The name
+    /// @param   node The osg node we are adding
+    /// @param   replace Replace the node or append to it (as in add())
+    /// @return  boolean True implies the add was queued for the display thread
+    bool add(const Path& path,
+             const osg::ref_ptr<osg::Node>& node,
+             const bool& replace = true)
+    {
+        return add(handle(path), node, replace);
+    };
+
+    /// @brief   Replace the node of a handle
+    /// @param   handle The handle from handle()
+    /// @param   node The osg node to show
+    /// @return  boolean True implies the add was queued for the display thread
+    bool replace(const Handle& handle,
+                 const osg::ref_ptr<osg::Node>& node)
+    {
+        return add(handle, node, true);
+    };
+
+    /// @brief   Coalescing replace of a named node
+    /// @param   name The name of the thing we are updating (same naming
+    ///          convention as add())
+    /// @param   node The osg node to display under this name
+    /// @return  boolean True if the node is pending for the display thread,
+    ///          false if it was thrown away by decimation or there is no display
+    ///
+    /// Each name has a single pending slot. The display thread applies the
+    /// slot (as a replacing add) once per frame, so a producer calling this at
+    /// hundreds of Hz only costs one tree update per frame - intermediate nodes
+    /// are simply overwritten before they are ever drawn. Use setUpdateLimit()
+    /// to further throttle a name. An add() of the name queues the pending
+    /// node ahead of itself, so the add is still the last thing shown.
+    bool update(const std::string& name,
+                const osg::ref_ptr<osg::Node>& node);
+
+    /// @brief   Throttle the coalesced updates of a name
+    /// @param   name The name given to update()
+    /// @param   maxRate The most times per second the name is applied to the
+    ///          display (0 means every frame)
+    /// @param   decimation Only every decimation-th call to update() is kept
+    ///          (1 keeps them all)
+    ///
+    /// A rate limited slot is held (and keeps being overwritten) until its
+    /// period has elapsed, so the most recent node is always the one shown.
+    void setUpdateLimit(const std::string& name,
+                        const double& maxRate,
+                        const unsigned int& decimation = 1);
+
+    /// @brief   Build the node for some data on a worker thread and then add it
+    /// @param   name The name of the node (same convention as add())
+    /// @param   data Any of the DisplayObjects inputs (PointVec_t, LineVec_t,
+    ///          VoxelVec_t, MeshGrid, ...) - pass it with std::move() and the
+    ///          caller only pays for the move
+    /// @param   args Any extra arguments of the matching d3::get() (e.g. the
+    ///          point size)
+    /// @return  A future that is true once the node is in the display (and
+    ///          false if it could not be built or added, was dropped by the
+    ///          queue policy, was superseded by a later add of the name, or the
+    ///          display shut down first)
+    ///
+    /// The d3::get() call that turns the data into osg geometry runs on a small
+    /// work-stealing pool owned by the display, and the built node is queued
+    /// like any other replacing add(). Builds finish in any order, so a built
+    /// node is only shown if nothing was given for the name since it was
+    /// submitted - a slow build never replaces a newer one.
+    /// @code
+    /// d3::PointVec_t cloud( fillCloud() );
+    /// auto done( d3::di().addAsync("lidar::cloud", std::move(cloud), 2.0f) );
+    /// ...
+    /// done.wait(); // only if you need to know it is on screen
+    /// @endcode
+    template<typename Data, typename... Args>
+    std::future<bool> addAsync(const std::string& name, Data&& data, Args&&... args)
+    {
+        // not even the move when nothing is displayed
+        if ( Backend::NONE == getBackend() ) return ready(true);
+
+        typedef typename std::decay<Data>::type Data_t;
+        std::shared_ptr<Data_t> pData( std::make_shared<Data_t>(std::forward<Data>(data)) );
+        return addBuilt(name,
+                        std::bind(&detail::buildNode<Data_t, typename std::decay<Args>::type...>,
+                                  pData, std::forward<Args>(args)...));
+    };
+
+    /// @brief   Add the node for some data, unless the name already shows the
+    ///          same data
+    /// @param   name The name of the node (same convention as add())
+    /// @param   data Any of the plain DisplayObjects inputs (PointVec_t,
+    ///          LineVec_t, Grid, ...)
+    /// @param   args Any extra arguments of the matching d3::get() (e.g. the
+    ///          point size)
+    /// @return  boolean True if the name shows the data (or the add was queued)
+    ///
+    /// For the static content re-added every cycle of a loop. The data is
+    /// hashed (see d3::hash()) and if the name was last given the same data
+    /// nothing is built - the display thread only makes sure that node is
+    /// still the one under the name. Names given the same data share one
+    /// built geometry, each under its own group so they still show and hide
+    /// on their own.
+    /// @code
+    /// while ( running )
+    /// {
+    ///     d3::di().addHashed("ground", d3::Grid{...}); // only built once
+    ///     ...
+    /// }
+    /// @endcode
+    template<typename Data, typename... Args>
+    bool addHashed(const std::string& name, const Data& data, const Args&... args)
+    {
+        // not even the hash when nothing is displayed
+        if ( Backend::NONE == getBackend() ) return true;
+
+        return addShared(name,
+                         detail::hashArgs(hash(data, typeid(Data).hash_code()), args...),
+                         [&]() { return detail::build(data, args...); });
+    };
+
+    /// @brief   Add a node that will be edited while it is displayed
+    /// @param   name The name of the node (same convention as add())
+    /// @param   node The node to display
+    /// @param   copyOp How the back copies of the node are made
+    /// @return  The buffer to edit and publish (null if there is no display)
+    ///
+    /// This replaces the try_lock()/edit/unlock() dance. The producer edits
+    /// buffer->back() without any locking and calls buffer->publish(), the
+    /// display swaps the published copy in at the start of the next frame. No
+    /// update is ever lost to a busy lock. See SwapBuffer.
+    template<typename T>
+    osg::ref_ptr<SwapBuffer<T>> addBuffered(const std::string& name,
+                                            const osg::ref_ptr<T>& node,
+                                            const osg::CopyOp& copyOp = osg::CopyOp::SHALLOW_COPY)
+    {
+        if ( Backend::DISPLAY != getBackend() )
+        {
+            record(name, node.get());
+            return nullptr;
+        }
+
+        osg::ref_ptr<SwapBuffer<T>> buffer( new SwapBuffer<T>(node, copyOp) );
+        if ( not addSwapBuffer(name, buffer.get()) ) return nullptr;
+        return buffer;
+    };
+
     /// @brief   Method to add a function bound to a keypress
     /// @param   key The key to bind to this function
     /// @param   func The function to call when the key is pressed
     /// @param   description The description of the function
-    /// @return  boolean True implies success
+    /// @return  boolean True implies the handler was queued for the display
+    ///          thread
     ///
     /// This is the add function that allows arbitrary functions to be tied to
     /// key events.
@@ -172,7 +544,8 @@ class DisplayInterface
     /// @param   button The mouse button to bind to this function
     /// @param   func The function to call when the key is pressed
     /// @param   description The description of the function
-    /// @return  boolean True implies success
+    /// @return  boolean True implies the handler was queued for the display
+    ///          thread
     bool add(const osgGA::GUIEventAdapter::MouseButtonMask& button,
              const std::function<bool(const osgGA::GUIEventAdapter&)>& func,
              const std::string& description = "NONE");
@@ -180,7 +553,8 @@ class DisplayInterface
     /// @brief   Add a method to handle mouse movement events
     /// @param   func The function to call for mouse movements
     /// @param   description The description of the function (i.e. for help)
-    /// @return  boolean True implies success
+    /// @return  boolean True implies the handler was queued for the display
+    ///          thread
     /// @note    The function will only be called when no mouse buttons are
     ///          pressed, and only when the event type is "MOVE"
     bool add(const std::function<bool(const osgGA::GUIEventAdapter&)>& func,
@@ -208,10 +582,150 @@ class DisplayInterface
     /// method allows this by not returning until the main window has closed.
     void blockForClose();
 
+    /// @brief   Wait for the window to close, but not forever
+    /// @param   timeout The longest to wait
+    /// @return  boolean True if the window is closed (or was never opened),
+    ///          false if the timeout expired first
+    ///
+    /// This returns as soon as the window closes, so it can be used in the
+    /// condition of a processing loop:
+    /// @code
+    /// while ( not d3::di().waitForClose(std::chrono::milliseconds(0)) )
+    ///     step();
+    /// @endcode
+    bool waitForClose(const std::chrono::milliseconds& timeout);
+
+    /// @brief   Register a function to call when the window closes
+    /// @param   callback The function - it is called on the display thread, or
+    ///          right away on this thread if the window has already closed
+    void onClose(const std::function<void()>& callback);
+
+    /// @brief   Show or hide many names at once
+    /// @param   pattern A glob (with '*', '?' or '[') matched against the full
+    ///          names (e.g. "tracks::*::velocity"), or else a prefix of the full
+    ///          names (e.g. "tracks::car" shows or hides "tracks::car 1",
+    ///          "tracks::car 2", ... and everything under them)
+    /// @param   visible Show or hide them
+    /// @return  boolean True if the change was queued for the display thread
+    ///
+    /// This is the same as clicking each of the checkboxes in the tree, but all
+    /// of them are changed under a single lock between two frames. Only the
+    /// names already added are changed, so before the first add it does
+    /// nothing (and doesn't open the window).
+    bool setVisible(const std::string& pattern,
+                    const bool& visible);
+
+    /// @brief   Remove a name and everything under it from the display
+    /// @param   name The full name given to add()
+    /// @return  boolean True if the removal was queued for the display thread
+    ///
+    /// Adds queued before the removal are applied first, a pending update() of
+    /// the name is dropped. The nodes' GL objects (vertex buffers, textures)
+    /// are deleted on the display thread at the next frame, so a removed
+    /// point cloud gives back its memory rather than only being hidden.
+    bool remove(const std::string& name);
+
+    /// @brief   Remove every name starting with a prefix
+    /// @param   prefix The prefix (e.g. "tracks::car" removes "tracks::car 1",
+    ///          "tracks::car 2", ... and everything under them), empty removes
+    ///          everything
+    /// @return  boolean True if the removal was queued for the display thread
+    bool clear(const std::string& prefix = "");
+
+    /// @brief   Keep the last versions of a name to scrub back through
+    /// @param   name The full name given to add() (and the names under it),
+    ///          empty keeps the versions of everything
+    /// @param   versions The most versions kept of each name, 0 stops keeping
+    ///          them
+    /// @return  boolean True if the change was kept or queued for the display
+    ///          thread
+    ///
+    /// Each add() that replaces the name keeps the node it adds with the time
+    /// of the add, and the timeline at the bottom of the window scrubs every
+    /// name with versions back to the same time. The versions are the nodes
+    /// given to add() (so they must not be changed after), and an add with the
+    /// same content as a kept version shares it.
+    bool setHistory(const std::string& name,
+                    const size_t& versions);
+
+    /// @brief   Set the most bytes of geometry kept by all the versions
+    /// @param   bytes The budget (256MB to begin with), the least recently
+    ///          added or shown versions are dropped to stay under it
+    /// @return  boolean True if the change was kept or queued for the display
+    ///          thread
+    bool setHistoryBudget(const size_t& bytes);
+
+    /// @{
+    /// @name    Control of when frames are rendered
+
+    /// @brief   Only render a frame when something changed
+    /// @param   onDemand True to render on demand, false to render every tick
+    ///          of the render timer (the default)
+    /// @return  boolean True if the change was kept or queued for the display
+    ///          thread
+    ///
+    /// In on demand mode a frame is rendered only after an add or update, a
+    /// checkbox toggle in the tree, an input event, an unlock(), a swap buffer
+    /// publish, a manipulator animation (e.g. a thrown trackball) or
+    /// requestRedraw(). An idle window then costs next to nothing.
+    bool setOnDemandRendering(const bool& onDemand);
+
+    /// @brief   Set the most frames rendered per second
+    /// @param   fps The frame rate cap (30 by default)
+    /// @return  boolean True if the change was kept or queued for the display
+    ///          thread
+    bool setMaxFrameRate(const double& fps);
+
+    /// @brief   Ask for a frame in on demand mode
+    ///
+    /// Only needed if you change the scene without going through the display
+    /// interface (e.g. from an osg callback).
+    void requestRedraw();
+    /// @}
+
+    /// @brief   Wait for everything added so far to reach the display
+    /// @return  A future which is ready once the display thread has applied
+    ///          every command queued before this call
+    ///
+    /// This is a fence, handy for tests and measurements. Updates held back by
+    /// setUpdateLimit() are not waited for.
+    std::future<void> flush();
+
+    /// @brief   What the STATS backend has counted so far
+    Stats_t getStats() const;
+
+    /// @brief   Forget what the STATS backend has counted
+    void resetStats();
+
     /// @brief   Check to see if the display is running
     /// @return  boolean True if the window is open and the display is running
     bool running() const;
 
+    /// @{
+    /// @name    Control of the command queue between callers and the display
+
+    /// @brief   Set what add() does when the command queue is full
+    /// @param   policy BLOCK waits for the display thread, DROP_OLDEST throws
+    ///          away the oldest queued command and DROP_NEWEST throws away the
+    ///          command being added
+    ///
+    /// Only node adds are ever thrown away. A flush(), remove(), clear(),
+    /// setVisible() or handler registration waits for room whatever the policy,
+    /// and DROP_OLDEST waits too when the oldest command is one of those. A
+    /// handler adding from the display thread never waits - it runs the oldest
+    /// commands to make room.
+    void setQueuePolicy(const QueuePolicy& policy);
+
+    /// @brief   Get the current queue full policy
+    QueuePolicy getQueuePolicy() const;
+
+    /// @brief   Number of queued commands thrown away under DROP_OLDEST
+    uint64_t getDroppedOldest() const;
+
+    /// @brief   Number of commands thrown away under DROP_NEWEST
+    uint64_t getDroppedNewest() const;
+    /// @}
+
     /// @{
     /// @name    When we are manipulating stuff out from under osg
     ///
@@ -257,6 +771,97 @@ class DisplayInterface
 
   private:
 
+    /// The type of the commands handed to the display thread
+    typedef std::function<void()> Command_t;
+
+    /// What goes through the command queue - a command, or the add of a node
+    /// to a handle (which can be queued without allocating)
+    struct QueueEntry
+    {
+        /// @brief   Constructor - empty
+        QueueEntry() :
+            command(),
+            pHandle(nullptr),
+            node(),
+            replace(true),
+            droppable(false)
+        {
+        };
+
+        /// @brief   Constructor for a command
+        QueueEntry(Command_t&& theCommand,
+                   const bool& theDroppable) :
+            command(std::move(theCommand)),
+            pHandle(nullptr),
+            node(),
+            replace(true),
+            droppable(theDroppable)
+        {
+        };
+
+        /// @brief   Constructor for a handle add
+        QueueEntry(detail::HandleEntry* pTheHandle,
+                   const osg::ref_ptr<osg::Node>& theNode,
+                   const bool& theReplace) :
+            command(),
+            pHandle(pTheHandle),
+            node(theNode),
+            replace(theReplace),
+            droppable(true)
+        {
+        };
+
+        /// The command (if this is not a handle add)
+        Command_t                 command;
+
+        /// The handle added to
+        detail::HandleEntry*      pHandle;
+
+        /// The node added to the handle
+        osg::ref_ptr<osg::Node>   node;
+
+        /// Replace or append
+        bool                      replace;
+
+        /// Only the plain node adds may be thrown away by the queue policy -
+        /// never a fence, a removal or a registration
+        bool                      droppable;
+    };
+
+    /// The interned handles by the hash of their name
+    typedef std::unordered_map<uint64_t, std::unique_ptr<detail::HandleEntry>> Handles_t;
+
+    /// The pending state of a name given to update()
+    struct UpdateSlot
+    {
+        /// The most recent node not yet applied
+        osg::ref_ptr<osg::Node>                  pending;
+
+        /// Set while the slot is in m_dirtySlots (pending may be null)
+        bool                                     dirty;
+
+        /// Keep every decimation-th update
+        unsigned int                             decimation;
+
+        /// Updates seen since the last one kept
+        unsigned int                             count;
+
+        /// The minimum time between applying this slot
+        std::chrono::steady_clock::duration      minPeriod;
+
+        /// The last time this slot was applied
+        std::chrono::steady_clock::time_point    lastApplied;
+    };
+
+    /// The slots by name
+    typedef std::unordered_map<std::string, UpdateSlot> UpdateSlots_t;
+
+    /// Builds a node on the worker pool
+    typedef std::function<osg::ref_ptr<osg::Node>()> Builder_t;
+
+    /// The pump calls drain() on the display thread
+    friend class CommandPump;
+
     /// @brief   Hidden constructor
     ///
     /// This class is a singleton, and so the default constructor is private by
@@ -280,8 +885,160 @@ class DisplayInterface
     /// many places and only does work if the main window is not already created
     bool setupMainWindow();
 
+    /// @brief   Account for an add that does not go to the display
+    /// @param   name The name of the add
+    /// @param   node What was added
+    /// @return  boolean Always true - the add was taken care of
+    bool record(const std::string& name,
+                const osg::Node* node);
+
+    /// @brief   A future that is already set
+    static std::future<bool> ready(const bool& value);
+
+    /// @brief   Note that we have data and make sure the window is up
+    /// @return  boolean True if there is a display to add to
+    bool prepareAdd();
+
+    /// @brief   Hand a setting to the display thread, or keep it for when the
+    ///          display is set up
+    /// @param   setting The command applying the setting on the display thread
+    /// @return  boolean True if the setting was kept or queued
+    ///
+    /// Settings are usually given up front, and must not open the window
+    /// before there is anything to show.
+    bool configure(Command_t&& setting);
+
+    /// @brief   Hand a command to the display thread
+    /// @param   command The command to run on the display thread
+    /// @param   droppable True if the command is a plain node add the queue
+    ///          policy may throw away
+    /// @return  boolean True if the command was queued (false if the window
+    ///          could not be setup or the command was dropped)
+    bool enqueue(Command_t&& command,
+                 const bool& droppable = false);
+
+    /// @brief   Hand a command or handle add to the display thread
+    /// @param   entry What to queue
+    /// @return  boolean True if queued
+    ///
+    /// The display thread is the one draining the queue, so it never waits on
+    /// it - a handler adding to a full queue runs the oldest commands itself to
+    /// make room.
+    bool enqueue(QueueEntry&& entry);
+
+    /// @brief   Run a queued entry - only called on the display thread with
+    ///          osg locked
+    /// @param   entry What was queued
+    void run(const QueueEntry& entry);
+
+    /// @brief   Intern a name
+    /// @param   hash The hash of the name
+    /// @param   name The name
+    /// @return  Handle The handle (invalid if another name has the same hash)
+    Handle intern(const uint64_t& hash,
+                  const char* name);
+
+    /// @brief   Drop the pending update(), the addHashed() data and the
+    ///          addAsync() builds in flight of the names being removed
+    /// @param   prefix The names starting with this are dropped
+    /// @param   whole Only drop the name itself and the names under it, not
+    ///          every name starting with it
+    void dropUpdates(const std::string& prefix,
+                     const bool& whole);
+
+    /// @brief   Queue the pending update() of a name ahead of an add of it
+    /// @param   name The full name being added
+    ///
+    /// The slots are applied after the commands, so without this an update()
+    /// followed by an add() of the same name would end up showing the update.
+    void flushUpdate(const std::string& name);
+
+    /// @brief   Note an addAsync() of a name being submitted
+    /// @param   name The full name
+    /// @return  The ticket of the build - only the newest of the name counts
+    uint64_t startBuild(const std::string& name);
+
+    /// @brief   Make the builds of a name in flight stale - every other add of
+    ///          the name calls this before it is queued
+    /// @param   name The full name
+    void supersede(const std::string& name);
+
+    /// @brief   Stop tracking a build
+    /// @param   name The full name
+    /// @param   ticket The ticket of the build
+    /// @return  boolean True if nothing was given for the name since the build
+    ///          was submitted
+    bool finishBuild(const std::string& name,
+                     const uint64_t& ticket);
+
+    /// @brief   Apply an add to a handle - only called on the display thread
+    /// @param   entry The queued add
+    void applyHandle(const QueueEntry& entry);
+
+    /// @brief   Called from the main window on the display thread once it has
+    ///          closed
+    void windowClosed();
+
+    /// @brief   Make sure the display thread will drain the queue
+    ///
+    /// Only the first call after a drain posts an event to the display thread,
+    /// so a burst of adds costs a single wakeup.
+    void wake();
+
+    /// @brief   Apply the queued commands and updates - the display thread's
+    ///          handler for wake()
+    void drain();
+
+    /// @brief   Apply the pending update slots - only called on the display
+    ///          thread
+    /// @return  How long until the next rate limited slot is due (max() if
+    ///          none are held back)
+    std::chrono::steady_clock::duration processUpdates();
+
+    /// @brief   Queue the add of a swap buffer (the non-template part of
+    ///          addBuffered())
+    /// @param   name The name of the buffered node
+    /// @param   buffer The buffer
+    /// @return  boolean True if queued
+    bool addSwapBuffer(const std::string& name,
+                       const osg::ref_ptr<SwapBufferBase>& buffer);
+
+    /// @brief   Run a builder on the worker pool and queue the add of its node
+    ///          (the non-template part of addAsync())
+    /// @param   name The name of the node
+    /// @param   builder Makes the node
+    /// @return  The future handed back by addAsync()
+    std::future<bool> addBuilt(const std::string& name,
+                               Builder_t&& builder);
+
+    /// @brief   Add a name's node for hashed data (the non-template part of
+    ///          addHashed())
+    /// @param   name The name of the node
+    /// @param   key The hash of the data
+    /// @param   builder Makes the node if no name shows the data yet
+    /// @return  boolean True if the name shows the data or the add was queued
+    bool addShared(const std::string& name,
+                   const uint64_t& key,
+                   const Builder_t& builder);
+
+    /// @brief   Apply a committed batch - only called on the display thread
+    /// @param   entries The entries of the batch
+    void applyBatch(const std::vector<Batch::Entry>& entries);
+
+    /// @brief   Run the queued commands - only called on the display thread
+    ///          with osg locked
+    /// @return  How long until the next rate limited update is due (max() if
+    ///          there is none)
+    ///
+    /// At most one queue's worth of commands is run per call so a flood of adds
+    /// cannot starve the event processing - if there is more, another wake is
+    /// posted behind the events already waiting.
+    std::chrono::steady_clock::duration processCommands();
+
     /// @brief   The display loop runs in a thread
     ///
+    /// The thread is only started by the first add (through setupMainWindow())
+    /// so a process that never displays anything never pays for it.
     void displayThreadLoop();
 
     /// The main window that is displayed
@@ -305,12 +1062,117 @@ class DisplayInterface
     /// Flag to indicate when the setup is complete
     bool                          m_setupComplete;
 
+    /// The settings given before the setup, applied by it (protected by
+    /// m_mutex)
+    std::vector<Command_t>        m_settings;
+
     /// Thread Running
     std::thread                   m_displayThread;
 
+    /// Starts the display thread once
+    std::once_flag                m_threadOnce;
+
     /// flag for thread
     bool                          m_threadShouldRun;
+
+    /// Protects m_pPump between the producers posting to it and the display
+    /// thread destroying it
+    std::mutex                    m_pumpMutex;
+
+    /// Receives the wake events on the display thread (made and destroyed
+    /// there)
+    std::unique_ptr<CommandPump>  m_pPump;
+
+    /// Set while a wake event is on its way to the display thread
+    std::atomic<bool>             m_wakePending;
+
+    /// Set while the main window is open
+    std::atomic<bool>             m_windowOpen;
+
+    /// The display thread once it is running
+    std::atomic<std::thread::id>  m_displayThreadId;
+
+    /// Protects the close callbacks and pairs with m_closeNotify
+    std::mutex                    m_closeMutex;
+
+    /// Notified when the window closes
+    std::condition_variable       m_closeNotify;
+
+    /// The functions given to onClose()
+    std::vector<std::function<void()>> m_closeCallbacks;
+
+    /// The commands waiting for the display thread
+    CommandQueue<QueueEntry>      m_commands;
+
+    /// What to do when the command queue is full
+    std::atomic<QueuePolicy>      m_queuePolicy;
+
+    /// Protects the update slots (never held while touching the display)
+    std::mutex                    m_slotMutex;
+
+    /// The coalescing update slots
+    UpdateSlots_t                 m_updateSlots;
+
+    /// The slots with something pending
+    std::vector<UpdateSlots_t::value_type*> m_dirtySlots;
+
+    /// The size of m_dirtySlots, so an add only takes the slot lock when
+    /// something is pending
+    std::atomic<size_t>           m_numDirty;
+
+    /// Makes the worker pool the first time addAsync() is called
+    std::once_flag                m_poolOnce;
+
+    /// The workers for addAsync()
+    std::unique_ptr<ThreadPool>   m_pPool;
+
+    /// Protects the builds
+    std::mutex                    m_buildMutex;
+
+    /// The ticket of the newest addAsync() of each name still in flight
+    std::unordered_map<std::string, uint64_t> m_builds;
+
+    /// The last ticket handed out
+    uint64_t                      m_buildTickets;
+
+    /// The size of m_builds, so an add only takes the build lock when
+    /// something is being built
+    std::atomic<size_t>           m_numBuilds;
+
+    /// Protects the handles
+    std::mutex                    m_handleMutex;
+
+    /// The interned handles
+    Handles_t                     m_handles;
+
+    /// What a name added by addHashed() shows
+    struct Hashed
+    {
+        /// The hash of the data
+        uint64_t                     key;
+
+        /// The name's group over the shared node (gone once it is replaced)
+        osg::observer_ptr<osg::Group> group;
+    };
+
+    /// Protects the hashed names and shared nodes
+    std::mutex                    m_hashMutex;
+
+    /// The names added by addHashed()
+    std::unordered_map<std::string, Hashed> m_hashedNames;
+
+    /// The nodes built for hashed data, by hash
+    std::unordered_map<uint64_t, osg::observer_ptr<osg::Node>> m_sharedNodes;
+
+    /// Sweep the dead shared nodes once there are this many
+    size_t                        m_sharedSweep;
+
+    /// Protects the stats
+    mutable std::mutex            m_statsMutex;
+
+    /// What the STATS backend counted
+    Stats_t                       m_stats;
 };
 
 } // namespace d3
-
+#endif   // D3_DISABLE
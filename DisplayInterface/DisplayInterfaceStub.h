@@ -0,0 +1,183 @@
+/////////////////////////////////////////////////////////////////
+/// @file      DisplayInterfaceStub.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Header only stand-in for the display interface when it is
+///            compiled out with D3_DISABLE
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <DDDisplayObjects/Disable.h>
+#include <DDDisplayInterface/Append.h>
+#include <DDDisplayInterface/Backend.h>
+#include <DDDisplayInterface/CommandQueue.h>
+#include <DDDisplayInterface/Path.h>
+#include <DDDisplayInterface/SwapBuffer.h>
+#include <DDDisplayInterface/TimeToLive.h>
+
+#include <osg/Group>
+#include <osg/Node>
+#include <osgGA/GUIEventAdapter>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <string>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The display interface with every method an inline no-op
+///
+/// This has the same public interface as the real DisplayInterface, so code
+/// which doesn't wrap its calls in D3() still compiles with D3_DISABLE, and
+/// since every body is empty and inline the optimizer throws the calls away and
+/// nothing from the d3 libraries needs to be linked. See Disable.h.
+/////////////////////////////////////////////////////////////////
+class DisplayInterface
+{
+  public:
+
+    /// @brief   Constructor - constexpr so di() needs no guarded static
+    constexpr DisplayInterface() {};
+
+    /// @{
+    /// @name Noncopyable
+    DisplayInterface(const DisplayInterface&) = delete;
+    DisplayInterface& operator=(const DisplayInterface&) = delete;
+    /// @}
+
+    /// A group of adds that goes nowhere
+    class Batch
+    {
+      public:
+        template<typename... Args>
+        void add(Args&&...) {};
+        bool commit() { return true; };
+        size_t size() const { return 0; };
+    };
+
+    /// What the STATS backend counted for a name
+    struct NameStats
+    {
+        uint64_t calls;
+        uint64_t bytes;
+    };
+
+    /// The stats by name
+    typedef std::map<std::string, NameStats> Stats_t;
+
+    Batch beginBatch() { return Batch(); };
+
+    /// @brief   Every add() overload - nodes, key, mouse and motion handlers
+    template<typename... Args>
+    bool add(Args&&...) { return true; };
+
+    Handle handle(const std::string&) { return Handle(); };
+
+    Handle handle(const Path&) { return Handle(); };
+
+    bool replace(const Handle&, const osg::ref_ptr<osg::Node>&) { return true; };
+
+    bool update(const std::string&, const osg::ref_ptr<osg::Node>&) { return true; };
+
+    void setUpdateLimit(const std::string&, const double&, const unsigned int& = 1) {};
+
+    template<typename Data, typename... Args>
+    std::future<bool> addAsync(const std::string&, Data&&, Args&&...) { return ready(true); };
+
+    template<typename Data, typename... Args>
+    bool addHashed(const std::string&, const Data&, const Args&...) { return true; };
+
+    template<typename T>
+    osg::ref_ptr<SwapBuffer<T>> addBuffered(const std::string&,
+                                            const osg::ref_ptr<T>&,
+                                            const osg::CopyOp& = osg::CopyOp::SHALLOW_COPY)
+    {
+        return nullptr;
+    };
+
+    bool track(const osg::ref_ptr<osg::Node>&,
+               const osg::Vec3d = osg::Vec3d(),
+               const osg::Vec3d = osg::Vec3d(),
+               const osg::Vec3d = osg::Vec3d()) { return true; };
+
+    void blockForClose() {};
+
+    bool waitForClose(const std::chrono::milliseconds&) { return true; };
+
+    void onClose(const std::function<void()>& callback) { callback(); };
+
+    bool setVisible(const std::string&, const bool&) { return true; };
+
+    bool remove(const std::string&) { return true; };
+
+    bool clear(const std::string& = "") { return true; };
+
+    bool setHistory(const std::string&, const size_t&) { return true; };
+
+    bool setHistoryBudget(const size_t&) { return true; };
+
+    bool setOnDemandRendering(const bool&) { return true; };
+
+    bool setMaxFrameRate(const double&) { return true; };
+
+    void requestRedraw() {};
+
+    std::future<void> flush()
+    {
+        std::promise<void> done;
+        done.set_value();
+        return done.get_future();
+    };
+
+    Stats_t getStats() const { return Stats_t(); };
+
+    void resetStats() {};
+
+    bool running() const { return false; };
+
+    void setQueuePolicy(const QueuePolicy&) {};
+
+    QueuePolicy getQueuePolicy() const { return QueuePolicy::BLOCK; };
+
+    uint64_t getDroppedOldest() const { return 0; };
+
+    uint64_t getDroppedNewest() const { return 0; };
+
+    bool lock() { return false; };
+
+    bool try_lock() __attribute__((warn_unused_result)) { return false; };
+
+    bool unlock() { return false; };
+
+    osg::ref_ptr<osg::Group> getRootGroup() const { return nullptr; };
+
+    bool setRootGroup(osg::ref_ptr<osg::Group>) { return false; };
+
+  private:
+
+    /// @brief   A future that is already set
+    static std::future<bool> ready(const bool& value)
+    {
+        std::promise<bool> done;
+        done.set_value(value);
+        return done.get_future();
+    };
+};
+
+/// @brief   The stand-in singleton
+inline DisplayInterface& di()
+{
+    static DisplayInterface instance;
+    return instance;
+}
+
+} // namespace d3
@@ -0,0 +1,464 @@
+/////////////////////////////////////////////////////////////////
+/// @file      History.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     The last few versions of replaced names, to scrub back through
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "History.h"
+
+#include <DDDisplayObjects/Hash.h>
+#include <DDDisplayObjects/Memory.h>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/MatrixTransform>
+#include <osg/NodeVisitor>
+
+#include <functional>
+#include <typeinfo>
+
+namespace d3
+{
+
+namespace
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Visitor hashing the content under a node
+///
+/// Groups, geodes, matrix transforms and geometries are hashed by what they
+/// hold, anything else by its address so it only matches itself. The state
+/// sets can't be hashed and are collected to compare instead. The arrays are
+/// hashed on their own and then mixed in, so their hashes can be kept for the
+/// next time the same array is seen.
+/////////////////////////////////////////////////////////////////
+class ContentVisitor : public osg::NodeVisitor
+{
+  public:
+
+    /// @brief   Constructor
+    /// @param   arrays The hash of each array (null for only the state sets)
+    explicit ContentVisitor(std::function<uint64_t(const osg::BufferData*)> arrays) :
+        osg::NodeVisitor(osg::NodeVisitor::TRAVERSE_ALL_CHILDREN),
+        m_arrays(arrays),
+        m_hash(0),
+        m_stateSets()
+    {
+        // the hidden stuff is content too
+        setNodeMaskOverride(~0);
+    };
+
+    /// @brief   The hash
+    uint64_t getHash() const { return m_hash; };
+
+    /// @brief   The state sets in the order they were found
+    const std::vector<const osg::StateSet*>& getStateSets() const { return m_stateSets; };
+
+    /// @brief   Any node
+    virtual void apply(osg::Node& node)
+    {
+        visit(node);
+        if ( (typeid(osg::Group) != typeid(node)) && (typeid(osg::Node) != typeid(node)) )
+            mix(&node, sizeof(&node));
+        traverse(node);
+    };
+
+    /// @brief   The matrix is the content of a transform
+    virtual void apply(osg::MatrixTransform& transform)
+    {
+        visit(transform);
+        if ( typeid(osg::MatrixTransform) != typeid(transform) )
+            mix(&transform, sizeof(&transform));
+        mix(transform.getMatrix().ptr(), 16*sizeof(osg::Matrix::value_type));
+        traverse(transform);
+    };
+
+    /// @brief   The geometry lives in the geodes
+    virtual void apply(osg::Geode& geode)
+    {
+        visit(geode);
+        for ( unsigned int ii(0) ; ii<geode.getNumDrawables() ; ++ii )
+        {
+            const osg::Drawable* drawable( geode.getDrawable(ii) );
+            m_stateSets.push_back(drawable->getStateSet());
+
+            const osg::Geometry* geometry( drawable->asGeometry() );
+            if ( not m_arrays ) continue;
+            if ( (nullptr == geometry) || (typeid(osg::Geometry) != typeid(*geometry)) )
+            {
+                mix(&drawable, sizeof(drawable));
+                continue;
+            }
+
+            mix(geometry->getVertexArray());
+            mix(geometry->getNormalArray());
+            mix(geometry->getColorArray());
+            for ( unsigned int jj(0) ; jj<geometry->getNumTexCoordArrays() ; ++jj )
+                mix(geometry->getTexCoordArray(jj));
+            for ( unsigned int jj(0) ; jj<geometry->getNumPrimitiveSets() ; ++jj )
+            {
+                const osg::PrimitiveSet* primitives( geometry->getPrimitiveSet(jj) );
+                const unsigned int header[3] = { primitives->getMode(),
+                                                 static_cast<unsigned int>(primitives->getType()),
+                                                 primitives->getNumIndices() };
+                mix(header, sizeof(header));
+                if ( const osg::DrawArrays* arrays = dynamic_cast<const osg::DrawArrays*>(primitives) )
+                {
+                    const int first( arrays->getFirst() );
+                    mix(&first, sizeof(first));
+                }
+                else if ( nullptr != primitives->getDataPointer() )
+                {
+                    const uint64_t indices( m_arrays(primitives) );
+                    mix(&indices, sizeof(indices));
+                }
+            }
+        }
+    };
+
+  private:
+
+    /// @brief   What every node has
+    void visit(const osg::Node& node)
+    {
+        if ( not m_arrays )
+        {
+            m_stateSets.push_back(node.getStateSet());
+            return;
+        }
+
+        const osg::Node::NodeMask mask( node.getNodeMask() );
+        mix(&mask, sizeof(mask));
+        m_stateSets.push_back(node.getStateSet());
+    };
+
+    /// @brief   Mix in an array (or its absence)
+    void mix(const osg::Array* array)
+    {
+        const unsigned int header[2] = { (nullptr == array) ? 0u : static_cast<unsigned int>(array->getType()),
+                                         (nullptr == array) ? 0u : array->getNumElements() };
+        mix(header, sizeof(header));
+        if ( nullptr == array ) return;
+
+        const uint64_t data( m_arrays(array) );
+        mix(&data, sizeof(data));
+    };
+
+    /// @brief   Mix in some bytes
+    void mix(const void* data,
+             const size_t& bytes)
+    {
+        m_hash = hash(data, bytes, m_hash);
+    };
+
+    /// The hash of an array
+    std::function<uint64_t(const osg::BufferData*)> m_arrays;
+
+    /// The running hash
+    uint64_t                          m_hash;
+
+    /// The state sets found
+    std::vector<const osg::StateSet*> m_stateSets;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Do two nodes with the same content hash have the same state
+/////////////////////////////////////////////////////////////////
+bool sameState(osg::Node* lhs,
+               osg::Node* rhs)
+{
+    // only the state sets are wanted, not the hashes
+    ContentVisitor lhsVisitor(nullptr);
+    lhs->accept(lhsVisitor);
+    ContentVisitor rhsVisitor(nullptr);
+    rhs->accept(rhsVisitor);
+
+    const std::vector<const osg::StateSet*>& lhsStates( lhsVisitor.getStateSets() );
+    const std::vector<const osg::StateSet*>& rhsStates( rhsVisitor.getStateSets() );
+    if ( lhsStates.size() != rhsStates.size() ) return false;
+    for ( size_t ii(0) ; ii<lhsStates.size() ; ++ii )
+    {
+        if ( (nullptr == lhsStates[ii]) || (nullptr == rhsStates[ii]) )
+        {
+            if ( lhsStates[ii] != rhsStates[ii] ) return false;
+        }
+        else if ( 0 != lhsStates[ii]->compare(*rhsStates[ii], true) )
+        {
+            return false;
+        }
+    }
+    return true;
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+History::History() :
+    m_tracked(),
+    m_versions(),
+    m_uses(),
+    m_shares(),
+    m_bytes(0),
+    m_budget(256*1024*1024),
+    m_arrayHashes(),
+    m_arrayHashesKept(0)
+{
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void History::track(const std::string& name,
+                    const size_t& versions)
+{
+    if ( 0 == versions ) m_tracked.erase(name);
+    else                 m_tracked[name] = versions;
+
+    // forget what is no longer tracked, and what is over the new limits
+    for ( auto& kept : m_versions )
+    {
+        const size_t limit( this->versions(kept.first) );
+        while ( kept.second.size() > limit )
+            drop(kept.second, kept.second.begin());
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+size_t History::versions(const std::string& name) const
+{
+    static const std::string splitIndicator("::");
+
+    // the longest tracked name that is this name or above it
+    size_t versions(0);
+    size_t longest(0);
+    for ( const auto& tracked : m_tracked )
+    {
+        const std::string& prefix( tracked.first );
+        if ( (prefix.size() < longest) || (0 != name.compare(0, prefix.size(), prefix)) ) continue;
+        if ( prefix.empty() || (name.size() == prefix.size()) ||
+             (0 == name.compare(prefix.size(), splitIndicator.size(), splitIndicator)) )
+        {
+            versions = tracked.second;
+            longest = prefix.size();
+        }
+    }
+    return versions;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void History::setBudget(const size_t& bytes)
+{
+    m_budget = bytes;
+    trim();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> History::record(const std::string& name,
+                                        const osg::ref_ptr<osg::Node>& node,
+                                        const Time_t& time)
+{
+    const size_t limit( versions(name) );
+    if ( (0 == limit) || not node ) return node;
+
+    std::deque<Version>& kept( m_versions[name] );
+
+    // the same content as a kept version shares its node
+    osg::ref_ptr<osg::Node> shown(node);
+    const uint64_t hash( contentHash(node.get()) );
+    for ( const Version& version : kept )
+    {
+        if ( (version.hash == hash) && sameState(version.node.get(), node.get()) )
+        {
+            shown = version.node;
+            break;
+        }
+    }
+
+    // unchanged since the latest version - it just got used again
+    if ( not kept.empty() && (kept.back().node == shown) )
+    {
+        m_uses.splice(m_uses.end(), m_uses, kept.back().use);
+        return shown;
+    }
+
+    kept.push_back(Version{time, shown, hash, m_uses.insert(m_uses.end(), Use{name, time})});
+    share(shown.get());
+
+    while ( kept.size() > limit )
+        drop(kept, kept.begin());
+    trim();
+
+    return shown;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> History::at(const std::string& name,
+                                    const Time_t& time)
+{
+    const auto kept( m_versions.find(name) );
+    if ( m_versions.end() == kept ) return nullptr;
+
+    for ( auto version(kept->second.rbegin()) ; version!=kept->second.rend() ; ++version )
+    {
+        if ( version->time > time ) continue;
+        m_uses.splice(m_uses.end(), m_uses, version->use);
+        return version->node;
+    }
+    return nullptr;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> History::latest(const std::string& name) const
+{
+    const auto kept( m_versions.find(name) );
+    if ( (m_versions.end() == kept) || kept->second.empty() ) return nullptr;
+    return kept->second.back().node;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void History::forget(const std::string& name)
+{
+    static const std::string splitIndicator("::");
+
+    for ( auto kept(m_versions.begin()) ; kept != m_versions.end() ; )
+    {
+        const std::string& other( kept->first );
+        if ( (0 != other.compare(0, name.size(), name)) ||
+             ((other.size() != name.size()) &&
+              (0 != other.compare(name.size(), splitIndicator.size(), splitIndicator))) )
+        {
+            ++kept;
+            continue;
+        }
+
+        while ( not kept->second.empty() )
+            drop(kept->second, kept->second.begin());
+        kept = m_versions.erase(kept);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::vector<std::string> History::names() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_versions.size());
+    for ( const auto& kept : m_versions )
+        if ( not kept.second.empty() )
+            names.push_back(kept.first);
+    return names;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool History::span(Time_t& oldest,
+                   Time_t& latest) const
+{
+    bool any(false);
+    for ( const auto& kept : m_versions )
+    {
+        if ( kept.second.empty() ) continue;
+        if ( not any || (kept.second.front().time < oldest) ) oldest = kept.second.front().time;
+        if ( not any || (kept.second.back().time > latest) )  latest = kept.second.back().time;
+        any = true;
+    }
+    return any;
+};
+
+/////////////////////////////////////////////////////////////////
+//////// PRIVATES //////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void History::share(const osg::Node* node)
+{
+    Share& share( m_shares[node] );
+    if ( 0 == share.count++ )
+    {
+        share.bytes = getByteSize(node);
+        m_bytes += share.bytes;
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void History::unshare(const osg::Node* node)
+{
+    const auto share( m_shares.find(node) );
+    if ( m_shares.end() == share ) return;
+    if ( 0 == --share->second.count )
+    {
+        m_bytes -= share->second.bytes;
+        m_shares.erase(share);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void History::drop(std::deque<Version>& versions,
+                   const std::deque<Version>::iterator& version)
+{
+    m_uses.erase(version->use);
+    unshare(version->node.get());
+    versions.erase(version);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void History::trim()
+{
+    while ( (m_bytes > m_budget) && not m_uses.empty() )
+    {
+        const Uses_t::iterator use( m_uses.begin() );
+        std::deque<Version>& kept( m_versions[use->name] );
+
+        auto version( kept.begin() );
+        while ( (kept.end() != version) && (version->use != use) ) ++version;
+        if ( kept.end() != version ) drop(kept, version);
+        else                         m_uses.erase(use);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+uint64_t History::contentHash(osg::Node* node)
+{
+    ContentVisitor visitor([this](const osg::BufferData* array)
+                           {
+                               ArrayHash& known( m_arrayHashes[array] );
+                               if ( (known.array.get() != array) || (known.modified != array->getModifiedCount()) )
+                               {
+                                   known.array = const_cast<osg::BufferData*>(array);
+                                   known.modified = array->getModifiedCount();
+                                   known.hash = hash(array->getDataPointer(), array->getTotalDataSize());
+                               }
+                               return known.hash;
+                           });
+    node->accept(visitor);
+
+    // forget the arrays that are gone once there are twice as many as before
+    if ( m_arrayHashes.size() > 2*m_arrayHashesKept + 1024 )
+    {
+        for ( auto known(m_arrayHashes.begin()) ; known != m_arrayHashes.end() ; )
+        {
+            if ( known->second.array.valid() ) ++known;
+            else                               known = m_arrayHashes.erase(known);
+        }
+        m_arrayHashesKept = m_arrayHashes.size();
+    }
+
+    return visitor.getHash();
+};
+
+} // namespace d3
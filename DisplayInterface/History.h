@@ -0,0 +1,198 @@
+/////////////////////////////////////////////////////////////////
+/// @file      History.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     The last few versions of replaced names, to scrub back through
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <osg/BufferObject>
+#include <osg/Node>
+#include <osg/observer_ptr>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Timestamped versions of the nodes replaced under some names
+///
+/// Only the names given to track() (and the names under them) keep a history.
+/// The versions are the added nodes themselves, shared rather than copied, so
+/// they must not be edited once added (see keeps()). A version with the same content as one
+/// already kept for the name shares that node, and all the versions together
+/// stay under a byte budget by dropping the least recently recorded or shown.
+/////////////////////////////////////////////////////////////////
+class History
+{
+  public:
+
+    /// A point in time
+    typedef std::chrono::steady_clock::time_point Time_t;
+
+    /// @brief   Constructor
+    History();
+
+    /// @brief   Keep the versions of a name and the names under it
+    /// @param   name The name
+    /// @param   versions The most versions to keep of each (0 stops keeping
+    ///          them and forgets the ones kept)
+    void track(const std::string& name,
+               const size_t& versions);
+
+    /// @brief   The most versions kept of a name (0 if it isn't tracked)
+    size_t versions(const std::string& name) const;
+
+    /// @brief   Is anything tracked
+    bool empty() const { return m_tracked.empty(); };
+
+    /// @brief   Set the most bytes of geometry kept by all the versions
+    void setBudget(const size_t& bytes);
+
+    /// @brief   The bytes of geometry kept
+    size_t getBytes() const { return m_bytes; };
+
+    /// @brief   Keep a new version of a name
+    /// @param   name The full name
+    /// @param   node The new node
+    /// @param   time When it was added
+    /// @return  The node to show - an earlier version if it has the same
+    ///          content, otherwise node
+    osg::ref_ptr<osg::Node> record(const std::string& name,
+                                   const osg::ref_ptr<osg::Node>& node,
+                                   const Time_t& time);
+
+    /// @brief   The version of a name at a time
+    /// @return  The latest version added at or before time, null if there is
+    ///          none
+    osg::ref_ptr<osg::Node> at(const std::string& name,
+                               const Time_t& time);
+
+    /// @brief   The latest version of a name (null if there is none)
+    osg::ref_ptr<osg::Node> latest(const std::string& name) const;
+
+    /// @brief   Forget the versions of a name and of the names under it
+    /// @param   name The full name (e.g. when it is removed)
+    void forget(const std::string& name);
+
+    /// @brief   Is a node kept as a version (so it must not be edited)
+    bool keeps(const osg::Node* node) const { return 0 != m_shares.count(node); };
+
+    /// @brief   The names with versions
+    std::vector<std::string> names() const;
+
+    /// @brief   The times of the oldest and latest versions of all names
+    /// @return  boolean False if there are no versions
+    bool span(Time_t& oldest,
+              Time_t& latest) const;
+
+  private:
+
+    /// A use of a version, least recent at the front
+    struct Use
+    {
+        std::string name;
+        Time_t      time;
+    };
+
+    /// The uses
+    typedef std::list<Use> Uses_t;
+
+    /// A version of a name
+    struct Version
+    {
+        /// When it was added
+        Time_t                  time;
+
+        /// The node
+        osg::ref_ptr<osg::Node> node;
+
+        /// The hash of its content
+        uint64_t                hash;
+
+        /// Its place in the uses
+        Uses_t::iterator        use;
+    };
+
+    /// The hash of an array, good while the array is alive and unmodified
+    struct ArrayHash
+    {
+        /// The array (to tell it from a new one at the same address)
+        osg::observer_ptr<osg::BufferData> array;
+
+        /// Its modified count when hashed
+        unsigned int                       modified;
+
+        /// The hash of its data
+        uint64_t                           hash;
+    };
+
+    /// The array hashes by array
+    typedef std::unordered_map<const osg::BufferData*, ArrayHash> ArrayHashes_t;
+
+    /// A node kept by one or more versions
+    struct Share
+    {
+        /// The number of versions
+        size_t count;
+
+        /// Its bytes of geometry
+        size_t bytes;
+    };
+
+    /// @brief   Count a version of a node
+    void share(const osg::Node* node);
+
+    /// @brief   Stop counting a version of a node
+    void unshare(const osg::Node* node);
+
+    /// @brief   Drop a version
+    void drop(std::deque<Version>& versions,
+              const std::deque<Version>::iterator& version);
+
+    /// @brief   Drop the least recently used versions until under budget
+    void trim();
+
+    /// @brief   Hash the content of a node, reusing the hashes of the arrays
+    ///          it shares with what was hashed before
+    uint64_t contentHash(osg::Node* node);
+
+    /// The versions to keep by tracked name
+    std::map<std::string, size_t>                      m_tracked;
+
+    /// The versions by full name, oldest first
+    std::unordered_map<std::string, std::deque<Version>> m_versions;
+
+    /// The uses of all the versions
+    Uses_t                                             m_uses;
+
+    /// The kept nodes
+    std::unordered_map<const osg::Node*, Share>        m_shares;
+
+    /// The bytes of all the kept nodes
+    size_t                                             m_bytes;
+
+    /// The most bytes to keep
+    size_t                                             m_budget;
+
+    /// The hashes of the arrays seen, so re-adding a node or sharing its
+    /// geometry doesn't hash it all again
+    ArrayHashes_t                                      m_arrayHashes;
+
+    /// The number of array hashes after the dead ones were last dropped
+    size_t                                             m_arrayHashesKept;
+};
+
+} // namespace d3
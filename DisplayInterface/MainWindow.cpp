@@ -14,7 +14,11 @@
 #include <QtGui/QTreeView>
 #include <QtGui/QActionGroup>
 #include <QtGui/QCheckBox>
+#include <QtGui/QLabel>
+#include <QtGui/QSlider>
+#include <QtGui/QToolBar>
 
+#include <algorithm>
 #include <iostream>
 
 namespace d3
@@ -27,7 +31,15 @@ MainWindow::MainWindow() :
     m_pOsgWidget(nullptr),
     m_pTree(nullptr),
     m_pMenuBar(),
-    m_timer()
+    m_timer(),
+    m_renderMode(RenderMode::CONTINUOUS),
+    m_closeCallback(),
+    m_pTimeline(nullptr),
+    m_pLive(nullptr),
+    m_pTimeSlider(nullptr),
+    m_pTimeLabel(nullptr),
+    m_timelineStart(),
+    m_timelineEnd()
 {
     // the menu widget
     QWidget* theMenuWidget( new QWidget() );
@@ -81,6 +93,33 @@ MainWindow::MainWindow() :
         QWidget::connect(pAction, SIGNAL(triggered()), this, SLOT(close()));
     }
 
+    // the timeline to scrub the histories, shown once there are any
+    {
+        static const int timelineSteps(1000);
+
+        m_pTimeline = new QToolBar("Timeline", this);
+        m_pTimeline->setObjectName("Timeline");
+        m_pTimeline->setMovable(false);
+
+        m_pLive = new QCheckBox("Live");
+        m_pLive->setChecked(true);
+        QWidget::connect(m_pLive, SIGNAL(toggled(bool)), this, SLOT(setLive(bool)));
+        m_pTimeline->addWidget(m_pLive);
+
+        m_pTimeSlider = new QSlider(Qt::Horizontal);
+        m_pTimeSlider->setRange(0, timelineSteps);
+        m_pTimeSlider->setValue(timelineSteps);
+        QWidget::connect(m_pTimeSlider, SIGNAL(valueChanged(int)), this, SLOT(timelineMoved(int)));
+        m_pTimeline->addWidget(m_pTimeSlider);
+
+        m_pTimeLabel = new QLabel();
+        m_pTimeLabel->setMinimumWidth(60);
+        m_pTimeline->addWidget(m_pTimeLabel);
+
+        addToolBar(Qt::BottomToolBarArea, m_pTimeline);
+        m_pTimeline->hide();
+    }
+
     // show everything
     show();
 };
@@ -107,6 +146,7 @@ void MainWindow::setOsgWidget(QOSGWidget* widget)
 
     // set the render timer
     connect(&m_timer, SIGNAL(timeout()), this, SLOT(render()));
+    connect(widget, SIGNAL(redrawRequested()), this, SLOT(wake()));
     m_timer.setInterval(33); // 33 = 30fps
     m_timer.start();
 };
@@ -118,8 +158,8 @@ void MainWindow::setTreeView(TreeView* treeView)
     if ( nullptr == treeView ) return;
 
     // Hold this tree view
-    //m_pTree = treeView;
-    
+    m_pTree = treeView;
+
     // build a dock widget
     QDockWidget *dockWidget = new QDockWidget("Displayed Items");
     dockWidget->setObjectName("Dock");
@@ -130,6 +170,24 @@ void MainWindow::setTreeView(TreeView* treeView)
     addDockWidget(Qt::RightDockWidgetArea, dockWidget);
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void MainWindow::setRenderMode(const RenderMode& mode)
+{
+    m_renderMode = mode;
+
+    // draw whatever is there now in case nothing changes for a while
+    if ( nullptr != m_pOsgWidget ) m_pOsgWidget->requestRedraw();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void MainWindow::setMaxFrameRate(const double& fps)
+{
+    if ( fps <= 0.0 ) return;
+    m_timer.setInterval(std::max(1, static_cast<int>(1000.0/fps + 0.5)));
+};
+
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 // bool MainWindow::add(const std::string& name,
@@ -181,19 +239,36 @@ void MainWindow::continuousCapture(bool checked)
 /////////////////////////////////////////////////////////////////
 void MainWindow::render()
 {
+    // bring the tree up to date with this frame's adds
+    if ( nullptr != m_pTree ) m_pTree->refresh();
+    updateTimeline();
+
     // make sure we have valid widget and we are visible
     if ( (nullptr != m_pOsgWidget) && isVisible() )
     {
         // try and get the lock
         if ( m_pOsgWidget->try_lock() )
         {
-            // update and unlock
-            m_pOsgWidget->updateGL();
+            // update (unless nothing changed) and unlock
+            if ( (RenderMode::CONTINUOUS == m_renderMode) || m_pOsgWidget->needsFrame() )
+                m_pOsgWidget->updateGL();
+
+            // nothing changed and nothing on the clock - stop ticking until
+            // the next redraw request
+            else if ( ((nullptr == m_pTree) || not m_pTree->timed()) && m_pOsgWidget->goIdle() )
+                m_timer.stop();
             m_pOsgWidget->unlock();
         }
     }
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void MainWindow::wake()
+{
+    if ( not m_timer.isActive() ) m_timer.start();
+};
+
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 void MainWindow::lock()     {        m_pOsgWidget->lock();     };
@@ -206,6 +281,51 @@ void MainWindow::setDarkClear()  { m_pOsgWidget->setClearColor(osg::Vec4(0.1, 0.
 void MainWindow::setLightClear() { m_pOsgWidget->setClearColor(osg::Vec4(0.5, 0.5, 0.5, 1.0)); };
 void MainWindow::setWhiteClear() { m_pOsgWidget->setClearColor(osg::Vec4(1.0, 1.0, 1.0, 1.0)); };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void MainWindow::timelineMoved(int value)
+{
+    if ( nullptr == m_pTree ) return;
+
+    // grabbing the slider leaves live
+    if ( m_pLive->isChecked() )
+    {
+        m_pLive->blockSignals(true);
+        m_pLive->setChecked(false);
+        m_pLive->blockSignals(false);
+        m_pTree->historySpan(m_timelineStart, m_timelineEnd);
+    }
+
+    const double fraction( static_cast<double>(value - m_pTimeSlider->minimum()) /
+                           std::max(1, m_pTimeSlider->maximum() - m_pTimeSlider->minimum()) );
+    const std::chrono::steady_clock::duration offset
+        ( std::chrono::duration_cast<std::chrono::steady_clock::duration>(fraction*(m_timelineEnd - m_timelineStart)) );
+    m_pTree->showTime(m_timelineStart + offset);
+
+    // label it by how long before the latest version it is
+    const double before( std::chrono::duration<double>(m_timelineEnd - m_timelineStart - offset).count() );
+    m_pTimeLabel->setText(QString::number(-before, 'f', 2) + " s");
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void MainWindow::setLive(bool live)
+{
+    if ( nullptr == m_pTree ) return;
+
+    if ( live )
+    {
+        m_pTree->showLive();
+        updateTimeline();
+    }
+    else
+    {
+        // freeze the span where it is to scrub through it
+        m_pTree->historySpan(m_timelineStart, m_timelineEnd);
+        timelineMoved(m_pTimeSlider->value());
+    }
+};
+
 /////////////////////////////////////////////////////////////////
 ///////////// PRIVATES /////////////////////////////////////////
 ///////////////////////////////////////////////////////////////
@@ -248,11 +368,32 @@ void MainWindow::buildDisplayMenu(QMenu* dspMenu)
     }
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void MainWindow::updateTimeline()
+{
+    if ( (nullptr == m_pTree) || (nullptr == m_pTimeline) || not m_pLive->isChecked() ) return;
+
+    // nothing to scrub until there are versions
+    if ( not m_pTree->historySpan(m_timelineStart, m_timelineEnd) ) return;
+    if ( m_pTimeline->isHidden() ) m_pTimeline->show();
+
+    // while live the slider follows the latest
+    m_pTimeSlider->blockSignals(true);
+    m_pTimeSlider->setValue(m_pTimeSlider->maximum());
+    m_pTimeSlider->blockSignals(false);
+    m_pTimeLabel->setText("live");
+};
+
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 void MainWindow::closeEvent(QCloseEvent* theEvent)
 {
     QMainWindow::closeEvent(theEvent);
+
+    // let the display interface know right away
+    if ( theEvent->isAccepted() && m_closeCallback )
+        m_closeCallback();
 };
 
 } // namespace d3
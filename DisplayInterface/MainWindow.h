@@ -17,6 +17,8 @@
 #include <QtGui/QSplitter>
 
 #include <osg/Node>
+#include <chrono>
+#include <functional>
 #include <mutex>
 
 namespace d3
@@ -35,6 +37,13 @@ class MainWindow : public QMainWindow
 
   public:
 
+    /// @brief   When frames are rendered
+    enum class RenderMode
+    {
+        CONTINUOUS = 0, ///< Every tick of the render timer
+        ON_DEMAND       ///< Only on the ticks where something changed
+    };
+
     /// @brief   Constructor
     MainWindow();
 
@@ -47,6 +56,19 @@ class MainWindow : public QMainWindow
     /// @brief   Add the tree view
     void setTreeView(TreeView* treeView);
 
+    /// @brief   Set when frames are rendered
+    void setRenderMode(const RenderMode& mode);
+
+    /// @brief   Get when frames are rendered
+    const RenderMode& getRenderMode() const { return m_renderMode; };
+
+    /// @brief   Set the most frames rendered per second (the render timer rate)
+    void setMaxFrameRate(const double& fps);
+
+    /// @brief   Set the function called (on the display thread) once the
+    ///          window has closed
+    void setCloseCallback(const std::function<void()>& callback) { m_closeCallback = callback; };
+
   public Q_SLOTS:
 
     /// @brief   Method to make things go full screen
@@ -61,6 +83,16 @@ class MainWindow : public QMainWindow
     /// @brief   Activate a frame render
     void render();
 
+    /// @brief   Start the render timer again after it went idle
+    void wake();
+
+    /// @brief   Show the histories at a point on the timeline
+    /// @param   value Where on the timeline (0 is the oldest version)
+    void timelineMoved(int value);
+
+    /// @brief   Show the latest versions, or freeze the timeline to scrub it
+    void setLive(bool live);
+
     /// @{
     /// @name    Public locking functionality
     void lock();
@@ -81,6 +113,10 @@ class MainWindow : public QMainWindow
     /// @param   dspMenu The display menu to build
     void buildDisplayMenu(QMenu* dspMenu);
 
+    /// @brief   Show the timeline once there are versions and follow the
+    ///          latest while live
+    void updateTimeline();
+
     /// @brief   The method for window closing
     virtual void closeEvent(QCloseEvent *ev);
 
@@ -95,6 +131,30 @@ class MainWindow : public QMainWindow
 
     /// The timer to render the frame
     QTimer                    m_timer;
+
+    /// When frames are rendered
+    RenderMode                m_renderMode;
+
+    /// Called when the window closes
+    std::function<void()>     m_closeCallback;
+
+    /// The timeline bar (hidden until there are versions)
+    QToolBar*                 m_pTimeline;
+
+    /// Showing the latest versions
+    QCheckBox*                m_pLive;
+
+    /// Scrubbing the timeline
+    QSlider*                  m_pTimeSlider;
+
+    /// The time shown
+    QLabel*                   m_pTimeLabel;
+
+    /// @{
+    /// @name    The span of the timeline, frozen while scrubbing
+    std::chrono::steady_clock::time_point m_timelineStart;
+    std::chrono::steady_clock::time_point m_timelineEnd;
+    /// @}
 };
 
 } // namespace d3
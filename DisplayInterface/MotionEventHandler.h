@@ -41,6 +41,9 @@ class MotionEventHandler : public osgGA::GUIEventHandler
     bool add(const std::function<bool(const osgGA::GUIEventAdapter&)>& func,
              const std::string& description);
 
+    /// @brief   Is anything listening for motion
+    bool empty() const { return m_motionFuncs.empty(); };
+
     /// @brief   Override the base's handle function
     /// @param   eventAdapter The osg gui adapter event
     virtual bool handle(const osgGA::GUIEventAdapter& eventAdapter,
@@ -0,0 +1,101 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Path.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Names resolved once for adds in a tight loop
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace d3
+{
+
+namespace detail
+{
+/// The interned state behind a Handle (owned by the display interface)
+struct HandleEntry;
+
+/// @brief   64 bit FNV-1a of a string, usable at compile time
+/// @param   str The (null terminated) string
+/// @param   hash The hash so far
+constexpr uint64_t pathHash(const char* str,
+                            const uint64_t hash = 14695981039346656037ull)
+{
+    return ('\0' == *str) ? hash :
+        pathHash(str + 1, (hash ^ static_cast<uint64_t>(static_cast<unsigned char>(*str))) * 1099511628211ull);
+}
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A name (same convention as DisplayInterface::add()) hashed at
+///          compile time
+///
+/// @code
+/// static constexpr d3::Path egoPath("tracks::ego");
+/// while ( running )
+///     d3::di().add( egoPath, d3::get(ego) );
+/// @endcode
+/// Two different names are assumed never to share a 64 bit hash.
+/////////////////////////////////////////////////////////////////
+class Path
+{
+  public:
+
+    /// @brief   Constructor
+    /// @param   name The name - it must outlive the path (a string literal)
+    constexpr explicit Path(const char* name) :
+        m_name(name),
+        m_hash(detail::pathHash(name))
+    {
+    };
+
+    /// @{
+    /// @brief   Accessors
+    constexpr const char* name() const { return m_name; };
+    constexpr uint64_t hash() const { return m_hash; };
+    /// @}
+
+  private:
+
+    /// The name
+    const char*  m_name;
+
+    /// The hash of the name
+    uint64_t     m_hash;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A name interned by DisplayInterface::handle()
+///
+/// Adding to a handle does no string work and allocates nothing, the display
+/// thread goes straight to the tree entry found by the first add. Handles are
+/// cheap to copy and stay valid for the life of the display.
+/////////////////////////////////////////////////////////////////
+class Handle
+{
+  public:
+
+    /// @brief   Constructor - an invalid handle
+    Handle() : m_pEntry(nullptr) {};
+
+    /// @brief   Is this a handle from DisplayInterface::handle()
+    bool valid() const { return nullptr != m_pEntry; };
+
+  private:
+
+    /// Only the display interface hands these out
+    friend class DisplayInterface;
+
+    /// @brief   Construct for an interned entry
+    explicit Handle(detail::HandleEntry* pEntry) : m_pEntry(pEntry) {};
+
+    /// The interned entry
+    detail::HandleEntry* m_pEntry;
+};
+
+} // namespace d3
@@ -9,6 +9,7 @@
 
 #include "QOSGWidget.h"
 
+#include <osg/Geode>
 #include <osg/MatrixTransform>
 #include <osgViewer/ViewerEventHandlers>
 #include <osg/Point>
@@ -22,6 +23,14 @@
 #include <QtGui/QActionGroup>
 #include <QtGui/QtGui>
 
+#include <osg/GLObjects>
+
+#ifdef   __GLIBC__
+#include <malloc.h>
+#endif   // __GLIBC__
+
+#include <algorithm>
+
 namespace d3
 {
 
@@ -45,7 +54,12 @@ QOSGWidget::QOSGWidget(QWidget* pp) :
     m_pRoot(new osg::Group()),
     m_osgLock(),
 
-    m_pScreenshotCallback(new ScreenshotCallback(GL_BACK))
+    m_pScreenshotCallback(new ScreenshotCallback(GL_BACK)),
+    m_swapBuffers(),
+    m_released(),
+    m_frameCount(0),
+    m_dirty(true),
+    m_idle(false)
 {
     // Allow this widget to get click focus (for setting focus on key events and
     // such)
@@ -237,13 +251,52 @@ void QOSGWidget::updateGL()
     // do the frame and update
     if ( m_pOsgViewer && try_lock() )
     {
+        // anything changing from here on needs another frame
+        m_dirty = false;
+
+        swapBuffers();
         makeCurrent();
         m_pOsgViewer->frame();
+        ++m_frameCount;
+
+        // the frame just drawn no longer refers to anything released before
+        // it, so now it can all go
+        releaseNodes();
         QGLWidget::updateGL();
         unlock();
     }
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool QOSGWidget::needsFrame()
+{
+    if ( m_dirty ) return true;
+
+    for ( const auto& buffer : m_swapBuffers )
+        if ( buffer->pending() ) return true;
+
+    // pending events, manipulator animation and update callbacks
+    return m_pOsgViewer && m_pOsgViewer->checkNeedToDoFrame();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool QOSGWidget::goIdle()
+{
+    // swap buffers are published without a redraw request, so they are polled
+    if ( not m_swapBuffers.empty() ) return false;
+
+    // idle first, so a request racing the check below still wakes us
+    m_idle = true;
+    if ( needsFrame() )
+    {
+        m_idle = false;
+        return false;
+    }
+    return true;
+};
+
 /////////////////////////////////////////////////////////////////
 //////// PRIVATES //////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////
@@ -252,6 +305,7 @@ void QOSGWidget::updateGL()
 /////////////////////////////////////////////////////////////////
 void QOSGWidget::mousePressEvent(QMouseEvent* qEvent)
 {
+    requestRedraw();
     switch ( qEvent->button() )
     {
     case Qt::LeftButton:  m_pEventQueue->mouseButtonPress(qEvent->x(), qEvent->y(), 1); break;
@@ -265,6 +319,7 @@ void QOSGWidget::mousePressEvent(QMouseEvent* qEvent)
 /////////////////////////////////////////////////////////////////
 void QOSGWidget::mouseReleaseEvent(QMouseEvent* qEvent)
 {
+    requestRedraw();
     switch ( qEvent->button() )
     {
     case Qt::LeftButton:  m_pEventQueue->mouseButtonRelease(qEvent->x(), qEvent->y(), 1); break;
@@ -278,13 +333,19 @@ void QOSGWidget::mouseReleaseEvent(QMouseEvent* qEvent)
 /////////////////////////////////////////////////////////////////
 void QOSGWidget::mouseMoveEvent(QMouseEvent* qEvent)
 {
-     m_pEventQueue->mouseMotion(qEvent->x(), qEvent->y());
+    // hovering only matters to the motion handlers - a queued event is
+    // itself a reason for a frame, so don't queue one nobody handles
+    if ( (Qt::NoButton == qEvent->buttons()) && m_pMotionEventHandler->empty() ) return;
+
+    requestRedraw();
+    m_pEventQueue->mouseMotion(qEvent->x(), qEvent->y());
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 void QOSGWidget::mouseDoubleClickEvent( QMouseEvent* qEvent )
 {
+    requestRedraw();
     switch ( qEvent->button() )
     {
     case Qt::LeftButton:  m_pEventQueue->mouseDoubleButtonPress(qEvent->x(), qEvent->y(), 1); break;
@@ -298,6 +359,7 @@ void QOSGWidget::mouseDoubleClickEvent( QMouseEvent* qEvent )
 /////////////////////////////////////////////////////////////////
 void QOSGWidget::keyPressEvent( QKeyEvent* theEvent )
 {
+    requestRedraw();
     if ( not theEvent->isAutoRepeat() )
     {
         m_pEventQueue->keyPress( toOsg(theEvent) );
@@ -308,6 +370,7 @@ void QOSGWidget::keyPressEvent( QKeyEvent* theEvent )
 /////////////////////////////////////////////////////////////////
 void QOSGWidget::keyReleaseEvent( QKeyEvent* theEvent )
 {
+    requestRedraw();
     if ( not theEvent->isAutoRepeat() )
     {
         m_pEventQueue->keyRelease( toOsg(theEvent) );
@@ -318,11 +381,83 @@ void QOSGWidget::keyReleaseEvent( QKeyEvent* theEvent )
 /////////////////////////////////////////////////////////////////
 void QOSGWidget::wheelEvent( QWheelEvent* theEvent )
 {
+    requestRedraw();
     m_pEventQueue->mouseScroll(theEvent->delta() < 0 ?
                                osgGA::GUIEventAdapter::SCROLL_UP :
                                osgGA::GUIEventAdapter::SCROLL_DOWN);
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void QOSGWidget::swapBuffers()
+{
+    // forget the buffers that have been taken out of the scene
+    m_swapBuffers.erase(std::remove_if(m_swapBuffers.begin(), m_swapBuffers.end(),
+                                       [](const osg::ref_ptr<SwapBufferBase>& buffer)
+                                       {
+                                           return 0 == buffer->getGroup()->getNumParents();
+                                       }),
+                        m_swapBuffers.end());
+
+    for ( const auto& buffer : m_swapBuffers )
+        buffer->swap();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void QOSGWidget::releaseUnshared(osg::Node* node,
+                                 osg::State* state)
+{
+    // held by more than its one parent (or the released list) - it's still
+    // shown by another name, kept by a history or held by the caller
+    if ( 1 < node->referenceCount() ) return;
+
+    osg::StateSet* stateSet( node->getStateSet() );
+    if ( (nullptr != stateSet) && (1 == stateSet->referenceCount()) )
+        stateSet->releaseGLObjects(state);
+
+    osg::Geode* geode( node->asGeode() );
+    osg::Group* group( node->asGroup() );
+    if ( nullptr != geode )
+    {
+        for ( unsigned int ii(0) ; ii<geode->getNumDrawables() ; ++ii )
+            if ( 1 == geode->getDrawable(ii)->referenceCount() )
+                geode->getDrawable(ii)->releaseGLObjects(state);
+    }
+    else if ( nullptr != group )
+    {
+        for ( unsigned int ii(0) ; ii<group->getNumChildren() ; ++ii )
+            releaseUnshared(group->getChild(ii), state);
+    }
+    else
+    {
+        node->releaseGLObjects(state);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void QOSGWidget::releaseNodes()
+{
+    if ( m_released.empty() ) return;
+
+    osg::State* state( m_pGraphicsWindow->getState() );
+    for ( const auto& node : m_released )
+        releaseUnshared(node.get(), state);
+
+    // osg deletes orphaned GL objects a few milliseconds' worth per frame -
+    // a removal is rare and usually big, so delete all of them now
+    if ( nullptr != state )
+        osg::flushAllDeletedGLObjects(state->getContextID());
+
+    // dropping the last references frees the arrays and images, then hand
+    // the freed heap back
+    m_released.clear();
+#ifdef   __GLIBC__
+    malloc_trim(0);
+#endif   // __GLIBC__
+};
+
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 osgGA::GUIEventAdapter::KeySymbol QOSGWidget::toOsg(QKeyEvent *theEvent)
@@ -13,6 +13,7 @@
 #include "MotionEventHandler.h"
 #include "KeypressEventHandler.h"
 #include "ClickEventHandler.h"
+#include "SwapBuffer.h"
 
 #include <QtCore/QTimer>
 #include <QtGui/QKeyEvent>
@@ -27,8 +28,11 @@
 #include <osg/ClipNode>
 #include <osgText/Text>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <mutex>
+#include <vector>
 
 namespace d3
 {
@@ -159,6 +163,31 @@ class QOSGWidget : public QGLWidget
         return m_pClickEventHandler->add(button, func, description);
     };
 
+    /// @brief   Register a swap buffer to be swapped at the start of each frame
+    /// @param   buffer The buffer (its group should already be in the scene)
+    /// @note    The buffer is dropped once its group is no longer in the scene
+    inline void addSwapBuffer(const osg::ref_ptr<SwapBufferBase>& buffer)
+    {
+        lock();
+        m_swapBuffers.push_back(buffer);
+        unlock();
+    };
+
+    /// @brief   Let go of a node taken out of the scene
+    /// @param   node The node (and everything below it)
+    ///
+    /// Its GL objects (vertex buffers, textures, display lists) are deleted at
+    /// the next frame while the context is current, and the heap is handed
+    /// back to the system after - except for the parts still referred to
+    /// from anywhere else.
+    inline void release(const osg::ref_ptr<osg::Node>& node)
+    {
+        lock();
+        m_released.push_back(node);
+        unlock();
+        requestRedraw();
+    };
+
     /// @brief   non-const access to the manipulator
     inline osg::ref_ptr<osgGA::CameraManipulator> getManipulator() { return m_currentManipulator; };
 
@@ -168,6 +197,31 @@ class QOSGWidget : public QGLWidget
     /// @brief   Update the GL for the widget
     virtual void updateGL();
 
+    /// @brief   Note that the scene changed and the next frame should be drawn
+    ///          (thread safe)
+    ///
+    /// Wakes the render timer if it was stopped by goIdle().
+    void requestRedraw()
+    {
+        m_dirty = true;
+        if ( m_idle.exchange(false) ) Q_EMIT redrawRequested();
+    };
+
+    /// @brief   The number of frames drawn so far
+    uint64_t frameCount() const { return m_frameCount; };
+
+    /// @brief   Does anything need a new frame
+    /// @return  boolean True if the scene or the camera has changed since the
+    ///          last frame, there are osg events waiting, a manipulator is
+    ///          still animating (e.g. a throw) or a swap buffer was published
+    bool needsFrame();
+
+    /// @brief   Stop asking for frames until something changes
+    /// @return  boolean True if nothing needs a frame (and the next
+    ///          requestRedraw() will signal redrawRequested()), false if a
+    ///          frame is still needed or a swap buffer is being polled
+    bool goIdle();
+
     /// @{
     /// @name    Locking and unlocking mechanisms
     void lock()     { m_osgLock.lock();            };
@@ -175,6 +229,12 @@ class QOSGWidget : public QGLWidget
     void unlock()   { m_osgLock.unlock();          };
     /// @}
 
+  Q_SIGNALS:
+
+    /// @brief   Something needs a frame after goIdle() (may be emitted from
+    ///          any thread)
+    void redrawRequested();
+
   private Q_SLOTS:
 
   private:
@@ -197,12 +257,30 @@ class QOSGWidget : public QGLWidget
     {
         m_pEventQueue->windowResize(0, 0, ww, hh );
         m_pGraphicsWindow->resized(0, 0, ww, hh);
+        requestRedraw();
     };
     /// @}
 
     /// @brief   Get the osg key symbol
     osgGA::GUIEventAdapter::KeySymbol toOsg(QKeyEvent *event);
 
+    /// @brief   Bring the published swap buffer copies into the scene
+    void swapBuffers();
+
+    /// @brief   Delete the GL objects of the released nodes and drop them
+    /// @note    Only call with the context current
+    void releaseNodes();
+
+    /// @brief   Delete the GL objects of a node and of everything below it
+    ///          that nothing else refers to
+    /// @param   node The node
+    /// @param   state The state of the context
+    ///
+    /// Shared parts (another name, a history version, a node the caller
+    /// holds) keep their GL objects, since they may still be drawn.
+    static void releaseUnshared(osg::Node* node,
+                                osg::State* state);
+
     /// The graphics window
     osg::ref_ptr<osgViewer::GraphicsWindowEmbedded>                     m_pGraphicsWindow;
 
@@ -237,6 +315,22 @@ class QOSGWidget : public QGLWidget
 
     /// The screencapture
     osg::ref_ptr<ScreenshotCallback>                                    m_pScreenshotCallback;
+
+    /// The double buffered subtrees
+    std::vector<osg::ref_ptr<SwapBufferBase>>                           m_swapBuffers;
+
+    /// The nodes taken out of the scene, waiting to have their GL objects
+    /// deleted
+    std::vector<osg::ref_ptr<osg::Node>>                                m_released;
+
+    /// The number of frames drawn so far
+    uint64_t                                                            m_frameCount;
+
+    /// Set when something changed since the last frame
+    std::atomic<bool>                                                   m_dirty;
+
+    /// Set while nothing is asking for frames
+    std::atomic<bool>                                                   m_idle;
 };
 
 } // namespace d3
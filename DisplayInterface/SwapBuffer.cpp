@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////
+/// @file      SwapBuffer.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Buffered copies of a subtree that producers edit without
+///            locking the display
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "SwapBuffer.h"
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+SwapBufferBase::SwapBufferBase(osg::Node* front,
+                               osg::Node* middle,
+                               osg::Node* back) :
+    osg::Referenced(),
+    m_buffers{{front, middle, back}},
+    m_middle(1),
+    m_back(2),
+    m_front(0),
+    m_pGroup(new osg::Group())
+{
+    m_pGroup->addChild(m_buffers[m_front]);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+SwapBufferBase::~SwapBufferBase()
+{
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool SwapBufferBase::swap()
+{
+    // nothing new
+    if ( not pending() ) return false;
+
+    // trade the front for the freshly published middle
+    const uint8_t fresh( m_middle.exchange(m_front, std::memory_order_acq_rel) );
+    m_front = fresh & INDEX;
+
+    // and show it
+    m_pGroup->setChild(0, m_buffers[m_front]);
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void SwapBufferBase::publishBack()
+{
+    // the back becomes the fresh middle, and whatever was in the middle (either
+    // an unpicked-up copy or the old front) becomes the new back
+    const uint8_t old( m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) );
+    m_back = old & INDEX;
+};
+
+} // namespace d3
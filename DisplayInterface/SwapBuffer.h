@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////
+/// @file      SwapBuffer.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Buffered copies of a subtree that producers edit without
+///            locking the display
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <osg/Group>
+#include <osg/CopyOp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The type independent part of a SwapBuffer
+///
+/// Three copies of the subtree are kept. The display draws the front copy, the
+/// producer edits the back copy and the last published copy waits in the
+/// middle. publish() and swap() each exchange one index atomically, so
+/// neither side ever waits for the other.
+/////////////////////////////////////////////////////////////////
+class SwapBufferBase : public osg::Referenced
+{
+  public:
+
+    /// @brief   The group that goes in the scene (it holds the front copy)
+    osg::Group* getGroup() const { return m_pGroup.get(); };
+
+    /// @brief   Is there a published copy the display has not picked up
+    bool pending() const { return 0 != (m_middle.load(std::memory_order_acquire) & FRESH); };
+
+    /// @brief   Put the most recently published copy in the scene
+    /// @return  boolean True if the front copy changed
+    /// @note    Only call this from the display thread with osg locked
+    bool swap();
+
+  protected:
+
+    /// @brief   Constructor
+    /// @param   front The node initially displayed
+    /// @param   middle A copy of front
+    /// @param   back A copy of front
+    SwapBufferBase(osg::Node* front,
+                   osg::Node* middle,
+                   osg::Node* back);
+
+    /// @brief   Destructor
+    virtual ~SwapBufferBase();
+
+    /// @brief   The copy the producer is free to edit
+    osg::Node* backNode() const { return m_buffers[m_back].get(); };
+
+    /// @brief   Hand the back copy to the display and take a new back copy
+    void publishBack();
+
+  private:
+
+    /// Marks the middle index as published but not yet displayed
+    static const uint8_t FRESH = 0x4;
+
+    /// Pulls the buffer index out of the middle
+    static const uint8_t INDEX = 0x3;
+
+    /// The three copies
+    std::array<osg::ref_ptr<osg::Node>, 3> m_buffers;
+
+    /// The index of the middle copy (and the FRESH flag)
+    std::atomic<uint8_t>                   m_middle;
+
+    /// The index of the copy the producer is editing
+    uint8_t                                m_back;
+
+    /// The index of the copy in the scene
+    uint8_t                                m_front;
+
+    /// The scene side holder of the front copy
+    osg::ref_ptr<osg::Group>               m_pGroup;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A subtree that a producer can edit while it is being displayed
+///
+/// Rather than locking the display around edits (and losing the update when
+/// try_lock() fails) register the node with DisplayInterface::addBuffered()
+/// and edit the back() copy. publish() makes the edits visible at the start
+/// of the next frame.
+/// @code
+/// auto buffered( d3::di().addBuffered("robot", xform) );
+/// while ( running )
+/// {
+///     buffered->back()->setMatrix(pose);
+///     buffered->publish();
+/// }
+/// @endcode
+/// The back copy you get after publish() is an older copy, so write the full
+/// state you want displayed every time rather than incremental changes. The
+/// copies are made with the given osg::CopyOp - by default only the top node
+/// is copied and its children are shared between the copies, which is what you
+/// want when editing a transform or switch above fixed geometry.
+/////////////////////////////////////////////////////////////////
+template<typename T>
+class SwapBuffer : public SwapBufferBase
+{
+  public:
+
+    /// @brief   Constructor
+    /// @param   node The node to buffer (this becomes the first front copy)
+    /// @param   copyOp How to make the other two copies
+    explicit SwapBuffer(const osg::ref_ptr<T>& node,
+                        const osg::CopyOp& copyOp = osg::CopyOp::SHALLOW_COPY) :
+        SwapBufferBase(node.get(),
+                       static_cast<T*>(node->clone(copyOp)),
+                       static_cast<T*>(node->clone(copyOp)))
+    {
+    };
+
+    /// @brief   The copy to edit (producer thread only)
+    T* back() const { return static_cast<T*>(backNode()); };
+
+    /// @brief   Make the edits to back() visible from the next frame on
+    void publish() { publishBack(); };
+
+  protected:
+
+    /// @brief   Destructor
+    virtual ~SwapBuffer() {};
+};
+
+} // namespace d3
@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////
+/// @file      ThreadPool.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Small work-stealing pool for building geometry off the
+///            caller's thread
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(const unsigned int& numThreads /* = 0 */) :
+    m_workers(),
+    m_threads(),
+    m_pending(0),
+    m_next(0),
+    m_wakeMutex(),
+    m_wake(),
+    m_stop(false)
+{
+    // leave a core for the caller
+    unsigned int count( numThreads );
+    if ( 0 == count )
+    {
+        const unsigned int hw( std::thread::hardware_concurrency() );
+        count = (hw > 1) ? hw - 1 : 1;
+    }
+
+    for ( unsigned int ii(0) ; ii<count ; ++ii )
+        m_workers.emplace_back(new Worker());
+
+    for ( size_t ii(0) ; ii<m_workers.size() ; ++ii )
+        m_threads.emplace_back([this, ii]() { run(ii); });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> l_lock(m_wakeMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for ( auto& thrd : m_threads )
+        thrd.join();
+
+    // the tasks that never ran are dropped unrun - whatever they hold is let
+    // go here, which is how an addAsync() waiting on one hears about it
+    for ( auto& worker : m_workers )
+        worker->tasks.clear();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void ThreadPool::submit(Task_t&& task)
+{
+    Worker& worker( *m_workers[m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size()] );
+    {
+        std::lock_guard<std::mutex> l_lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+
+    // the wake mutex makes sure a worker that just found nothing to do can't
+    // miss this notification on its way to sleep
+    {
+        std::lock_guard<std::mutex> l_lock(m_wakeMutex);
+        m_pending.fetch_add(1, std::memory_order_release);
+    }
+    m_wake.notify_one();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void ThreadPool::run(const size_t& index)
+{
+    Task_t task;
+    while ( true )
+    {
+        if ( take(index, task) )
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        // nothing anywhere - sleep until there is
+        std::unique_lock<std::mutex> l_lock(m_wakeMutex);
+        m_wake.wait(l_lock, [this]()
+                    {
+                        return m_stop || (m_pending.load(std::memory_order_acquire) > 0);
+                    });
+        if ( m_stop ) return;
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool ThreadPool::take(const size_t& index, Task_t& task)
+{
+    // our own newest first
+    {
+        Worker& mine( *m_workers[index] );
+        std::lock_guard<std::mutex> l_lock(mine.mutex);
+        if ( not mine.tasks.empty() )
+        {
+            task = std::move(mine.tasks.back());
+            mine.tasks.pop_back();
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // then the oldest of everyone else's
+    for ( size_t ii(1) ; ii<m_workers.size() ; ++ii )
+    {
+        Worker& victim( *m_workers[(index + ii) % m_workers.size()] );
+        std::lock_guard<std::mutex> l_lock(victim.mutex);
+        if ( not victim.tasks.empty() )
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+};
+
+} // namespace d3
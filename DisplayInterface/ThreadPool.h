@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////
+/// @file      ThreadPool.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Small work-stealing pool for building geometry off the
+///            caller's thread
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A fixed set of worker threads, each with its own task deque
+///
+/// Tasks are dealt round-robin onto the workers' deques. A worker takes its
+/// newest task first (it is the most likely to be warm in cache) and when it
+/// runs dry it steals the oldest task from the other workers, so one large
+/// build doesn't hold up the small ones queued behind it.
+/////////////////////////////////////////////////////////////////
+class ThreadPool
+{
+  public:
+
+    /// The unit of work
+    typedef std::function<void()> Task_t;
+
+    /// @brief   Constructor
+    /// @param   numThreads The number of workers (0 picks one less than the
+    ///          number of hardware threads)
+    explicit ThreadPool(const unsigned int& numThreads = 0);
+
+    /// @brief   Destructor - stops the workers, tasks not yet started are
+    ///          dropped
+    ~ThreadPool();
+
+    /// @{
+    /// @name Noncopyable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    /// @}
+
+    /// @brief   Hand a task to the pool
+    /// @param   task The task to run on one of the workers
+    void submit(Task_t&& task);
+
+    /// @brief   The number of workers
+    size_t size() const { return m_threads.size(); };
+
+  private:
+
+    /// One worker's queue
+    struct Worker
+    {
+        std::mutex          mutex;
+        std::deque<Task_t>  tasks;
+    };
+
+    /// @brief   The worker thread loop
+    /// @param   index The index of this worker
+    void run(const size_t& index);
+
+    /// @brief   Take a task from our own deque or steal one
+    /// @param   index The index of the worker looking for work
+    /// @param   task Where the task goes
+    /// @return  boolean True if a task was found
+    bool take(const size_t& index, Task_t& task);
+
+    /// The per-worker deques
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    /// The worker threads
+    std::vector<std::thread>             m_threads;
+
+    /// Tasks submitted and not yet taken
+    std::atomic<size_t>                  m_pending;
+
+    /// Round-robin counter for submit
+    std::atomic<size_t>                  m_next;
+
+    /// For sleeping workers
+    std::mutex                           m_wakeMutex;
+
+    /// For waking workers
+    std::condition_variable              m_wake;
+
+    /// Set to stop the workers
+    bool                                 m_stop;
+};
+
+} // namespace d3
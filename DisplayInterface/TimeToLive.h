@@ -0,0 +1,76 @@
+/////////////////////////////////////////////////////////////////
+/// @file      TimeToLive.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     How long an add stays in the display
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   How long an added node stays in the display before the display
+///          thread takes it out again on its own
+///
+/// @code
+/// // this cycle's candidates, gone half a second later
+/// d3::di().add( "planner::candidates", d3::get(candidates), d3::TimeToLive::seconds(0.5), false );
+///
+/// // shown for exactly three frames
+/// d3::di().add( "planner::best", d3::get(best), d3::TimeToLive::frames(3) );
+/// @endcode
+/////////////////////////////////////////////////////////////////
+class TimeToLive
+{
+  public:
+
+    /// What the value counts
+    enum class Unit
+    {
+        SECONDS = 0, ///< Wall clock seconds from when the node is applied
+        FRAMES       ///< Frames drawn from when the node is applied
+    };
+
+    /// @brief   Live for a wall clock time
+    /// @param   seconds The time
+    static TimeToLive seconds(const double& seconds)
+    {
+        return TimeToLive(Unit::SECONDS, seconds);
+    };
+
+    /// @brief   Live for a number of frames
+    /// @param   count The number of frames
+    static TimeToLive frames(const unsigned int& count)
+    {
+        return TimeToLive(Unit::FRAMES, count);
+    };
+
+    /// @brief   What the value counts
+    const Unit& unit() const { return m_unit; };
+
+    /// @brief   The seconds or frames
+    const double& value() const { return m_value; };
+
+  private:
+
+    /// @brief   Constructor - use seconds() or frames()
+    TimeToLive(const Unit& unit,
+               const double& value) :
+        m_unit(unit),
+        m_value(value)
+    {
+    };
+
+    /// What the value counts
+    Unit   m_unit;
+
+    /// The seconds or frames
+    double m_value;
+};
+
+} // namespace d3
@@ -0,0 +1,262 @@
+/////////////////////////////////////////////////////////////////
+/// @file      TreeModel.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     The item model behind the tree view of displayed items
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "TreeModel.h"
+
+#include <algorithm>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+TreeModel::TreeModel(QObject* parent /* = nullptr */) :
+    QAbstractItemModel(parent),
+    m_root{"", nullptr, nullptr, 0, 0, true, true, 0, true, false, {}, {}},
+    m_pending()
+{
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+TreeModel::~TreeModel()
+{
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+TreeModel::Entry* TreeModel::append(Entry* parent,
+                                    const std::string& name,
+                                    const osg::ref_ptr<osg::Node>& node)
+{
+    const int row( static_cast<int>(parent->children.size()) );
+    parent->children.emplace_back(new Entry{name, node, parent, row, 0, true, true, 0, false, false, {}, {}});
+    Entry* added( parent->children.back().get() );
+    parent->byName[name] = added;
+
+    // the view only needs to hear about it if it is looking
+    if ( parent->fetched && not parent->pending )
+    {
+        parent->pending = true;
+        m_pending.push_back(parent);
+    }
+
+    return added;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeModel::remove(Entry* parent,
+                       const int& first,
+                       const int& last)
+{
+    if ( (first > last) || (first < 0) || (last >= static_cast<int>(parent->children.size())) )
+        return;
+
+    // only the rows the view knows about are taken out in front of it
+    const int lastShown( std::min(last, parent->shown - 1) );
+    const bool tell( (first <= lastShown) &&
+                     ((nullptr == parent->parent) || indexOf(parent).isValid()) );
+    if ( tell ) beginRemoveRows(indexOf(parent), first, lastShown);
+
+    for ( int ii(first) ; ii<=last ; ++ii )
+    {
+        forget(parent->children[ii].get());
+        parent->byName.erase(parent->children[ii]->name);
+    }
+    parent->children.erase(parent->children.begin() + first, parent->children.begin() + last + 1);
+    if ( first <= lastShown ) parent->shown -= lastShown - first + 1;
+    for ( size_t ii(first) ; ii<parent->children.size() ; ++ii )
+        parent->children[ii]->row = static_cast<int>(ii);
+
+    if ( tell ) endRemoveRows();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeModel::publish()
+{
+    if ( m_pending.empty() ) return false;
+
+    std::vector<Entry*> pending;
+    pending.swap(m_pending);
+    for ( Entry* theEntry : pending )
+    {
+        theEntry->pending = false;
+        show(theEntry);
+    }
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+TreeModel::Entry* TreeModel::entry(const QModelIndex& index) const
+{
+    if ( not index.isValid() ) return const_cast<Entry*>(&m_root);
+    return static_cast<Entry*>(index.internalPointer());
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+QModelIndex TreeModel::indexOf(const Entry* theEntry) const
+{
+    if ( (nullptr == theEntry) || (nullptr == theEntry->parent) ) return QModelIndex();
+    if ( theEntry->row >= theEntry->parent->shown ) return QModelIndex();
+    return createIndex(theEntry->row, 0, const_cast<Entry*>(theEntry));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeModel::changed(const Entry* theEntry)
+{
+    const QModelIndex idx( indexOf(theEntry) );
+    if ( idx.isValid() ) dataChanged(idx, idx);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+QModelIndex TreeModel::index(int row, int column, const QModelIndex& parent /* = QModelIndex() */) const
+{
+    const Entry* theParent( entry(parent) );
+    if ( (row < 0) || (row >= theParent->shown) || (0 != column) ) return QModelIndex();
+    return createIndex(row, column, theParent->children[row].get());
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+QModelIndex TreeModel::parent(const QModelIndex& index) const
+{
+    if ( not index.isValid() ) return QModelIndex();
+    return indexOf(entry(index)->parent);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int TreeModel::rowCount(const QModelIndex& parent /* = QModelIndex() */) const
+{
+    if ( parent.column() > 0 ) return 0;
+    return entry(parent)->shown;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int TreeModel::columnCount(const QModelIndex& /* parent = QModelIndex() */) const
+{
+    return 1;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeModel::hasChildren(const QModelIndex& parent /* = QModelIndex() */) const
+{
+    // true before the children have been fetched, so the view can expand it
+    return not entry(parent)->children.empty();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+QVariant TreeModel::data(const QModelIndex& index, int role /* = Qt::DisplayRole */) const
+{
+    if ( not index.isValid() ) return QVariant();
+
+    const Entry* theEntry( entry(index) );
+    switch ( role )
+    {
+    case Qt::DisplayRole:
+        return QString::fromStdString(theEntry->name);
+
+    case Qt::CheckStateRole:
+        return static_cast<int>(theEntry->checked ? Qt::Checked : Qt::Unchecked);
+
+    default:
+        return QVariant();
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeModel::setData(const QModelIndex& index, const QVariant& value, int role /* = Qt::EditRole */)
+{
+    if ( not index.isValid() || (Qt::CheckStateRole != role) ) return false;
+
+    // the view toggles the checkbox, the tree view applies it to the display
+    // when it gets the click
+    entry(index)->checked = (Qt::Checked == value.toInt());
+    dataChanged(index, index);
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+Qt::ItemFlags TreeModel::flags(const QModelIndex& index) const
+{
+    if ( not index.isValid() ) return Qt::NoItemFlags;
+
+    // the enabled state is worked out here rather than stored down the whole
+    // subtree on every click
+    const Entry* theEntry( entry(index) );
+    bool enabled( theEntry->enabled );
+    for ( const Entry* up(theEntry->parent) ; enabled && (nullptr != up) ; up = up->parent )
+        enabled = up->checked;
+
+    Qt::ItemFlags itemFlags( Qt::ItemIsSelectable | Qt::ItemIsUserCheckable );
+    if ( enabled ) itemFlags |= Qt::ItemIsEnabled;
+    return itemFlags;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeModel::canFetchMore(const QModelIndex& parent) const
+{
+    const Entry* theEntry( entry(parent) );
+    return theEntry->shown < static_cast<int>(theEntry->children.size());
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeModel::fetchMore(const QModelIndex& parent)
+{
+    // from here on new children of this entry are published as they come
+    Entry* theEntry( entry(parent) );
+    theEntry->fetched = true;
+    show(theEntry);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeModel::forget(Entry* theEntry)
+{
+    if ( theEntry->pending )
+        m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), theEntry), m_pending.end());
+
+    for ( const auto& child : theEntry->children )
+        forget(child.get());
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeModel::show(Entry* theEntry)
+{
+    const int count( static_cast<int>(theEntry->children.size()) );
+    if ( theEntry->shown >= count ) return;
+
+    // an entry the view hasn't seen yet will have it all when it does
+    if ( (nullptr != theEntry->parent) && not indexOf(theEntry).isValid() )
+    {
+        theEntry->shown = count;
+        return;
+    }
+
+    beginInsertRows(indexOf(theEntry), theEntry->shown, count - 1);
+    theEntry->shown = count;
+    endInsertRows();
+};
+
+} // namespace d3
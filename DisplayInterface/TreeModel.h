@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////
+/// @file      TreeModel.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     The item model behind the tree view of displayed items
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QtGui/QtGui>
+
+#include <osg/Node>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Item model over the displayed names
+///
+/// The entries are plain structs owned by their parent, there is no qt object
+/// per entry. Appending an entry doesn't tell the view anything: the rows of an
+/// entry the view has never expanded are only handed over when it asks for
+/// them (fetchMore()), and the new rows of expanded entries are handed over by
+/// publish() - once per frame, one insert per parent.
+/////////////////////////////////////////////////////////////////
+class TreeModel : public QAbstractItemModel
+{
+  public:
+
+    /// One displayed name
+    struct Entry
+    {
+        /// @brief   Find a child by name
+        /// @param   childName The name of the child
+        /// @return  The child, null if there is none
+        Entry* findChild(const std::string& childName) const
+        {
+            const auto itt( byName.find(childName) );
+            return (byName.end() == itt) ? nullptr : itt->second;
+        };
+
+        /// The name (the last part of the full name)
+        std::string                              name;
+
+        /// The node
+        osg::ref_ptr<osg::Node>                  node;
+
+        /// The parent (null for the invisible root)
+        Entry*                                   parent;
+
+        /// The row in the parent
+        int                                      row;
+
+        /// Where the node is in the parent's group (checked before use)
+        unsigned int                             nodeIndex;
+
+        /// The checkbox
+        bool                                     checked;
+
+        /// Grayed out or not (an entry is also grayed out when anything
+        /// above it is unchecked)
+        bool                                     enabled;
+
+        /// The number of children the view knows about
+        int                                      shown;
+
+        /// The view has asked for the children
+        bool                                     fetched;
+
+        /// Waiting for publish()
+        bool                                     pending;
+
+        /// The children
+        std::vector<std::unique_ptr<Entry>>      children;
+
+        /// The children by name
+        std::unordered_map<std::string, Entry*>  byName;
+    };
+
+    /// @brief   Constructor
+    /// @param   parent The qt parent
+    explicit TreeModel(QObject* parent = nullptr);
+
+    /// @brief   Destructor
+    virtual ~TreeModel();
+
+    /// @brief   The invisible root entry
+    Entry* root() { return &m_root; };
+
+    /// @brief   Append an entry (the view finds out on publish() or
+    ///          fetchMore())
+    /// @param   parent The parent entry
+    /// @param   name The name of the new entry
+    /// @param   node The node of the new entry
+    /// @return  The new entry (owned by the parent)
+    Entry* append(Entry* parent,
+                  const std::string& name,
+                  const osg::ref_ptr<osg::Node>& node);
+
+    /// @brief   Remove a run of children (and everything below them)
+    /// @param   parent The parent entry
+    /// @param   first The row of the first child to remove
+    /// @param   last The row of the last child to remove
+    void remove(Entry* parent,
+                const int& first,
+                const int& last);
+
+    /// @brief   Hand the rows appended since the last call to the view, for
+    ///          the entries it has expanded
+    /// @return  boolean True if any rows were handed over
+    bool publish();
+
+    /// @brief   The entry of an index
+    Entry* entry(const QModelIndex& index) const;
+
+    /// @brief   The index of an entry (invalid if the view doesn't know it yet)
+    QModelIndex indexOf(const Entry* theEntry) const;
+
+    /// @brief   Tell the view an entry's checkbox or enabled state changed
+    void changed(const Entry* theEntry);
+
+    /// @{
+    /// @name    QAbstractItemModel
+    virtual QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const;
+    virtual QModelIndex parent(const QModelIndex& index) const;
+    virtual int rowCount(const QModelIndex& parent = QModelIndex()) const;
+    virtual int columnCount(const QModelIndex& parent = QModelIndex()) const;
+    virtual bool hasChildren(const QModelIndex& parent = QModelIndex()) const;
+    virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+    virtual bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole);
+    virtual Qt::ItemFlags flags(const QModelIndex& index) const;
+    virtual bool canFetchMore(const QModelIndex& parent) const;
+    virtual void fetchMore(const QModelIndex& parent);
+    /// @}
+
+  private:
+
+    /// @brief   Hand all of an entry's children to the view
+    void show(Entry* theEntry);
+
+    /// @brief   Forget an entry and everything below it before it is deleted
+    void forget(Entry* theEntry);
+
+    /// The invisible root
+    Entry                    m_root;
+
+    /// The entries with rows waiting for publish()
+    std::vector<Entry*>      m_pending;
+};
+
+} // namespace d3
@@ -8,12 +8,18 @@
 /////////////////////////////////////////////////////////////////
 
 #include "TreeView.h"
+#include "AppendBuffer.h"
 #include "QOSGWidget.h"
+#include "WindowGroup.h"
 
 #include <QtGui/QTreeView>
 #include <QtGui/QActionGroup>
 #include <QtGui/QCheckBox>
 
+#include <fnmatch.h>
+
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
 namespace d3
@@ -25,7 +31,17 @@ TreeView::TreeView() :
     QTreeView(),
     m_pOsgWidget(nullptr),
     m_pModel(nullptr),
-    m_mutex()
+    m_mutex(),
+    m_updateDepth(0),
+    m_resizePending(false),
+    m_generation(0),
+    m_expireByTime(),
+    m_expireByFrame(),
+    m_deadlines(),
+    m_added(),
+    m_windows(),
+    m_history(),
+    m_live(true)
 {
     // connect for clicks to show/hide stuff
     QObject::connect(this,
@@ -47,12 +63,14 @@ TreeView::TreeView() :
 
     // make the qmodel
     m_mutex.lock();
-    m_pModel = new QStandardItemModel();
+    m_pModel = new TreeModel(this);
 
-    // add the model
+    // add the model - every row is one line of text, so let the view skip
+    // measuring each of them
     setModel( m_pModel );
     header()->hide();
     setAllColumnsShowFocus(true);
+    setUniformRowHeights(true);
     m_mutex.unlock();
 };
 
@@ -60,8 +78,8 @@ TreeView::TreeView() :
 /////////////////////////////////////////////////////////////////
 TreeView::~TreeView()
 {
-    m_pModel->clear();
-    reset();
+    // the model is our child and goes with us
+    setModel(nullptr);
 };
 
 /////////////////////////////////////////////////////////////////
@@ -77,9 +95,11 @@ void TreeView::setOsgWidget(QOSGWidget* widget)
     // get the lock
     m_mutex.lock();
 
-    // setup the top level entry for the root node
-    d3DisplayItem* topEntry(new d3DisplayItem("All Displayed Items", m_pOsgWidget->getRootGroup()));
-    m_pModel->appendRow(topEntry);
+    // setup the top level entry for the root node - it has no children yet
+    // so the view would never fetch it, and it is always looked at anyway
+    TreeModel::Entry* top( m_pModel->append(m_pModel->root(), "All Displayed Items", m_pOsgWidget->getRootGroup()) );
+    m_pModel->publish();
+    m_pModel->fetchMore(m_pModel->indexOf(top));
 
     // set to accomodate this width
     resizeColumnToContents(0);
@@ -96,7 +116,8 @@ void TreeView::setOsgWidget(QOSGWidget* widget)
 bool TreeView::add(const std::string& name,
                    const osg::ref_ptr<osg::Node> node,
                    const bool& showNode,
-                   const bool& replace)
+                   const bool& replace,
+                   const bool& merge /* = true */)
 {
     // by default enable the node
     static const bool enableNode(true);
@@ -107,8 +128,8 @@ bool TreeView::add(const std::string& name,
         // pass this along to the internal adder which does the adds based on items
         // and give it the top level item in the model
         m_mutex.lock();
-        d3DisplayItem* myItem(static_cast<d3DisplayItem*>(m_pModel->item(0)));
-        bool rv( add(name, node, enableNode, showNode, replace, myItem) );
+        Entry_t* myItem(m_pModel->root()->children.front().get());
+        bool rv( add(name, node, enableNode, showNode, replace, merge, myItem) );
         m_mutex.unlock();
 
         // we're done
@@ -119,6 +140,163 @@ bool TreeView::add(const std::string& name,
     return false;
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeView::add(const std::string& name,
+                   const osg::ref_ptr<osg::Node> node,
+                   const bool& showNode,
+                   const Append::Window& window)
+{
+    static const bool replace(true);
+
+    if ( nullptr == m_pOsgWidget ) return false;
+
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    Entry_t* entry( find(name) );
+
+    // a new name starts out as a window
+    if ( nullptr == entry )
+    {
+        osg::ref_ptr<WindowGroup> group( new WindowGroup(window, releaser()) );
+        group->append(node);
+        m_windows.push_back(group);
+        return add(name, group, showNode, replace);
+    }
+
+    // it has to be a leaf - evicting the node of an entry with children
+    // would take them out of the scene behind the tree's back
+    if ( not entry->children.empty() )
+    {
+        std::cerr << "ERROR - " << name << " has children, it can't be appended to as a window" << std::endl;
+        return false;
+    }
+
+    m_pOsgWidget->lock();
+    osg::ref_ptr<WindowGroup> group( dynamic_cast<WindowGroup*>(entry->node.get()) );
+    if ( not group )
+    {
+        // the new group takes over the entry's node mask and the node it
+        // already had becomes the oldest in the window
+        group = new WindowGroup(window, releaser());
+        group->setNodeMask(entry->node->getNodeMask());
+        entry->node->setNodeMask(~0);
+        group->append(entry->node);
+        swapNode(entry->parent->node->asGroup(), entry, group);
+        m_windows.push_back(group);
+    }
+
+    group->setWindow(window);
+    group->append(node);
+    m_pOsgWidget->unlock();
+
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeView::add(const std::string& name,
+                   const osg::ref_ptr<osg::Node> node,
+                   const bool& showNode,
+                   const bool& replace,
+                   const TimeToLive& ttl)
+{
+    static const bool merge(false);
+
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    m_added = nullptr;
+    if ( not add(name, node, showNode, replace, merge) ) return false;
+
+    expire(name, m_added, ttl);
+    m_added = nullptr;
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+TreeView::Entry_t* TreeView::find(const std::string& name)
+{
+    static const std::string splitIndicator("::");
+
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    Entry_t* entry(m_pModel->root()->children.front().get());
+
+    // one level of the name at a time
+    size_t start(0);
+    while ( nullptr != entry )
+    {
+        const size_t nameSplit( name.find(splitIndicator, start) );
+        if ( std::string::npos == nameSplit )
+            return findChild(entry, name.substr(start));
+
+        entry = findChild(entry, name.substr(start, nameSplit - start));
+        start = nameSplit + splitIndicator.size();
+    }
+    return nullptr;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeView::add(Entry_t* item,
+                   const osg::ref_ptr<osg::Node> node,
+                   const bool& replace,
+                   const bool& merge /* = true */)
+{
+    // by default enable the node
+    static const bool enableNode(true);
+
+    if ( (nullptr == m_pOsgWidget) || (nullptr == item) ) return false;
+
+    m_mutex.lock();
+    bool rv( addToEntry(item, node, enableNode, replace, merge, item->parent) );
+    m_mutex.unlock();
+
+    return rv;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::beginUpdate()
+{
+    m_mutex.lock();
+    if ( 0 == m_updateDepth++ )
+        setUpdatesEnabled(false);
+    m_mutex.unlock();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::endUpdate()
+{
+    m_mutex.lock();
+    if ( (m_updateDepth > 0) && (0 == --m_updateDepth) )
+        setUpdatesEnabled(true);
+    m_mutex.unlock();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::refresh()
+{
+    m_mutex.lock();
+    expireDue();
+    evictWindows();
+    if ( m_pModel->publish() ) m_resizePending = true;
+    if ( m_resizePending && (0 == m_updateDepth) )
+    {
+        m_resizePending = false;
+        resizeColumnToContents(0);
+    }
+    m_mutex.unlock();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeView::timed()
+{
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    return not m_expireByTime.empty() || not m_expireByFrame.empty() || not m_windows.empty();
+};
+
 /////////////////////////////////////////////////////////////////
 /////////////// SLOTS //////////////////////////////////////////
 ///////////////////////////////////////////////////////////////
@@ -128,27 +306,11 @@ bool TreeView::add(const std::string& name,
 void TreeView::clicked(const QModelIndex& index)
 {
     // make sure we have a valid osg and the window is visible
-    if ( (nullptr != m_pOsgWidget) )
+    if ( (nullptr != m_pOsgWidget) && index.isValid() )
     {
-        // lock the model view
+        // lock the model view and apply the checkbox the view just toggled
         m_mutex.lock();
-
-        // get the item from the menu index
-        d3DisplayItem* item = static_cast<d3DisplayItem*>(m_pModel->itemFromIndex(index));
-
-        // lock osg and set the node mask based on the checked state
-        m_pOsgWidget->lock();
-        if ( Qt::Checked == item->checkState() ) item->getNode()->setNodeMask(~0);
-        else                                     item->getNode()->setNodeMask(0);
-
-        // now we have to recursively process the children to have them match
-        // this entry's checked state
-        for ( int ii(0) ; ii<item->rowCount() ; ++ii )
-            updateChildren(static_cast<d3DisplayItem*>(item->child(ii)),
-                           Qt::Checked == item->checkState());
-
-        // unlock osg and the model view
-        m_pOsgWidget->unlock();
+        applyChecked(m_pModel->entry(index));
         m_mutex.unlock();
     }
 };
@@ -157,14 +319,19 @@ void TreeView::clicked(const QModelIndex& index)
 /////////////////////////////////////////////////////////////////
 void TreeView::expanded(const QModelIndex& index)
 {
-    resizeColumnToContents(0);
+    // the view asks for the children itself, this is in case it didn't
+    m_mutex.lock();
+    if ( m_pModel->canFetchMore(index) ) m_pModel->fetchMore(index);
+    m_mutex.unlock();
+
+    resizeColumns();
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 void TreeView::collapsed(const QModelIndex& index)
 {
-    resizeColumnToContents(0);
+    resizeColumns();
 };
 
 /////////////////////////////////////////////////////////////////
@@ -178,7 +345,8 @@ bool TreeView::add(const std::string& name,
                    const bool& enableNode,
                    const bool& showNode,
                    const bool& replace,
-                   d3DisplayItem* myParent)
+                   const bool& merge,
+                   Entry_t* myParent)
 {
     static const std::string splitIndicator("::");
 
@@ -195,11 +363,11 @@ bool TreeView::add(const std::string& name,
         std::string post( name.substr(nameSplit + splitIndicator.size(), name.size()) );
 
         // call the add parent
-        return addParent(pre, post, node, enableNode, showNode, replace, myParent);
+        return addParent(pre, post, node, enableNode, showNode, replace, merge, myParent);
     }
 
     // this must be a leaf node... do we already have this child?
-    d3DisplayItem* entry(findChild(myParent, name));
+    Entry_t* entry(findChild(myParent, name));
 
     // see if we need to create a new entry
     if ( nullptr == entry )
@@ -208,7 +376,7 @@ bool TreeView::add(const std::string& name,
     }
     else
     {
-        return addToEntry(entry, node, enableNode, replace, myParent);
+        return addToEntry(entry, node, enableNode, replace, merge, myParent);
     }
 
     return false;
@@ -220,27 +388,24 @@ bool TreeView::createNewEntry(const std::string& name,
                               const osg::ref_ptr<osg::Node> node,
                               const bool& enableNode,
                               const bool& showNode,
-                              d3DisplayItem* myParent)
+                              Entry_t* myParent)
 {
-    // create the entry for the item model
-    d3DisplayItem* entry( new d3DisplayItem(name, node) );
-    entry->setEnabled(enableNode);
-
-    // add this entry to the item model
+    // add an entry to the item model
     m_mutex.lock();
-    myParent->appendRow(entry);
-
-    // set to accomodate this width
-    resizeColumnToContents(0);
+    Entry_t* entry( m_pModel->append(myParent, name, node) );
+    entry->enabled = enableNode;
+    if ( not m_history.empty() )
+        entry->node = m_history.record(fullName(entry), node, std::chrono::steady_clock::now());
+    m_added = entry->node;
 
     // add the node to the osg tree
     m_pOsgWidget->lock();
-    myParent->getNode()->asGroup()->addChild(node);
+    attachNode(myParent->node->asGroup(), entry);
     m_pOsgWidget->unlock();
     if ( not showNode )
     {
-        entry->setCheckState(Qt::Unchecked);
-        clicked(m_pModel->indexFromItem(entry));
+        entry->checked = false;
+        applyChecked(entry);
     }
     m_mutex.unlock();
 
@@ -249,46 +414,56 @@ bool TreeView::createNewEntry(const std::string& name,
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-bool TreeView::addToEntry(d3DisplayItem* entry,
+bool TreeView::addToEntry(Entry_t* entry,
                           const osg::ref_ptr<osg::Node> node,
                           const bool& enableNode,
                           const bool& replace,
-                          d3DisplayItem* myParent)
+                          const bool& merge,
+                          Entry_t* myParent)
 {
     // add in the new node (maybe replace)
     if ( replace ) return replaceNode(entry, node, enableNode, myParent);
-    return                appendNode(entry, node, enableNode, myParent);
+    return                appendNode(entry, node, enableNode, merge, myParent);
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-bool TreeView::replaceNode(d3DisplayItem* entry,
+bool TreeView::replaceNode(Entry_t* entry,
                              const osg::ref_ptr<osg::Node> node,
                              const bool& enableNode,
-                             d3DisplayItem* myParent)
+                             Entry_t* myParent)
 {
     // get the lock
     m_pOsgWidget->lock();
 
-    // remove this entry child from the display
-    myParent->getNode()->asGroup()->removeChild(entry->getNode());
-
-    // set the new node mask to match the old one
-    node->setNodeMask(entry->getNode()->getNodeMask());
-
     // now lock the model view
     m_mutex.lock();
 
-    // set the node and enabled flags
-    entry->setNode(node);
-    entry->setEnabled(enableNode);
+    // keep the version if the name has a history - an unchanged version is
+    // shared with the one kept, and while scrubbing it is only kept
+    osg::ref_ptr<osg::Node> shown(node);
+    if ( not m_history.empty() && (0 != m_history.versions(fullName(entry))) )
+    {
+        shown = m_history.record(fullName(entry), node, std::chrono::steady_clock::now());
+        m_added = shown;
+        if ( not m_live ) shown = entry->node;
+    }
+    else
+    {
+        m_added = shown;
+    }
+
+    // set the new node mask to match the old one
+    shown->setNodeMask(entry->node->getNodeMask());
+
+    // put the new node where the old one was in my parent and set the enabled
+    // flag
+    if ( shown != entry->node ) swapNode(myParent->node->asGroup(), entry, shown);
+    setEntryEnabled(entry, enableNode);
 
     // unlock the model view
     m_mutex.unlock();
 
-    // now the entry is ready, so add it back as a child to my parent
-    myParent->getNode()->asGroup()->addChild(entry->getNode());
-
     // unlock osg
     m_pOsgWidget->unlock();
 
@@ -297,46 +472,61 @@ bool TreeView::replaceNode(d3DisplayItem* entry,
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-bool TreeView::appendNode(d3DisplayItem* entry,
+bool TreeView::appendNode(Entry_t* entry,
                             const osg::ref_ptr<osg::Node> node,
                             const bool& enableNode,
-                            d3DisplayItem* myParent)
+                            const bool& merge,
+                            Entry_t* myParent)
 {
     // get the osg lock
     m_pOsgWidget->lock();
 
-    // get this node as a group
-    osg::ref_ptr<osg::Group> group(entry->getNode()->asGroup());
-    if ( not group )
+    // get this node as a group - one kept by the history is a version that
+    // must not change, so it is copied (the children are shared) first
+    osg::ref_ptr<osg::Group> group(entry->node->asGroup());
+    if ( group && m_history.keeps(group.get()) && (nullptr == dynamic_cast<WindowGroup*>(group.get())) )
+    {
+        group = new osg::Group(*group, osg::CopyOp::SHALLOW_COPY);
+        m_mutex.lock();
+        swapNode(myParent->node->asGroup(), entry, group);
+        m_mutex.unlock();
+    }
+    else if ( not group )
     {
         // it's not a group, so make a new group and add this child
         group = new osg::Group();
-        group->addChild(entry->getNode());
-
-        // since this is a new group, the node mask should match the entry
-        group->setNodeMask(entry->getNode()->getNodeMask());
+        group->addChild(entry->node);
 
-        // in this case we also need to remove this child from the display
-        myParent->getNode()->asGroup()->removeChild(entry->getNode());
+        // since this is a new group, it takes over the entry's node mask and
+        // the node in it is always shown
+        group->setNodeMask(entry->node->getNodeMask());
+        entry->node->setNodeMask(~0);
 
-        // now lock the model view and set the node and enabled flag for
-        // our new group
+        // now lock the model view and put our new group where the node was
+        // in the display
         m_mutex.lock();
-        entry->setNode(group);
-        entry->getNode()->setNodeMask(~0);
+        swapNode(myParent->node->asGroup(), entry, group);
         m_mutex.unlock();
-
-        // now add this new group
-        myParent->getNode()->asGroup()->addChild(entry->getNode());
     }
 
     // set the enableNode flag
     m_mutex.lock();
-    entry->setEnabled(enableNode);
+    setEntryEnabled(entry, enableNode);
     m_mutex.unlock();
 
-    // add this node to the group
-    group->addChild(node);
+    // a window keeps its own books, streamed points and lines go into the
+    // growing buffer at the end of the group, anything else is one more child
+    WindowGroup* window( dynamic_cast<WindowGroup*>(group.get()) );
+    if ( nullptr != window )
+    {
+        window->append(node);
+        m_added = node;
+    }
+    else if ( not merge || not AppendBuffer::append(group, node) )
+    {
+        group->addChild(node);
+        m_added = node;
+    }
 
     // now we can unlock osg
     m_pOsgWidget->unlock();
@@ -352,87 +542,563 @@ bool TreeView::addParent(const std::string& parentName,
                          const bool& enableNode,
                          const bool& showNode,
                          const bool& replace,
-                         d3DisplayItem* myParent)
+                         const bool& merge,
+                         Entry_t* myParent)
 {
     // see if the parent we are about to add as an offspring already exists
-    d3DisplayItem* entry(findChild(myParent, parentName));
+    Entry_t* entry(findChild(myParent, parentName));
 
     // if it's null, we must create it
     if ( nullptr == entry )
     {
-        // here is the entry named by the firstPart as a group
-        entry = new d3DisplayItem(parentName, new osg::Group());
-        entry->setEnabled(true);
-
         // lock
         m_mutex.lock();
 
+        // here is the entry named by the firstPart as a group, in the item
+        // model
+        entry = m_pModel->append(myParent, parentName, new osg::Group());
+        entry->enabled = true;
+
         // add the node to the osg tree
         m_pOsgWidget->lock();
-        myParent->getNode()->asGroup()->addChild(entry->getNode());
+        attachNode(myParent->node->asGroup(), entry);
         m_pOsgWidget->unlock();
 
-        // add this entry to the item model
-        myParent->appendRow(entry);
-
-        // set to accomodate this width
-        resizeColumnToContents(0);
-
         // unlock
         m_mutex.unlock();
     }
 
     // make sure this entry is a group
-    osg::Group* group( entry->getNode()->asGroup() );
+    osg::Group* group( entry->node->asGroup() );
     if ( group )
     {
         // now we can recurse with this itemf
-        return add(childName, node, enableNode, showNode, replace, entry);
+        return add(childName, node, enableNode, showNode, replace, merge, entry);
     }
 
     // it wasn't a group...
     std::cerr << "ERROR - " << parentName << " already exists as a non-group ("
-              << entry->getNode()->className() << ")" << std::endl
+              << entry->node->className() << ")" << std::endl
               << " --> YOu can't added to an already-added thing that isn't a group" << std::endl;
     return false;
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-TreeView::d3DisplayItem* TreeView::findChild(const d3DisplayItem* myParent,
+TreeView::Entry_t* TreeView::findChild(const Entry_t* myParent,
                                                  const std::string& name)
 {
-    // go through the list of rows and see if we can find an entry with "name"
-    for ( int ii=0 ; ii<myParent->rowCount() ; ++ii )
+    // the children are hashed by name
+    return myParent->findChild(name);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::attachNode(osg::Group* group,
+                          Entry_t* entry)
+{
+    entry->nodeIndex = group->getNumChildren();
+    group->addChild(entry->node);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::swapNode(osg::Group* group,
+                        Entry_t* entry,
+                        const osg::ref_ptr<osg::Node>& node)
+{
+    // the remembered index is right unless someone changed the group behind
+    // our back, only then do we have to search for it
+    unsigned int index( entry->nodeIndex );
+    if ( (index >= group->getNumChildren()) ||
+         (group->getChild(index) != entry->node.get()) )
+        index = group->getChildIndex(entry->node);
+
+    entry->node = node;
+    if ( index < group->getNumChildren() )
     {
-        d3DisplayItem* ch = static_cast<d3DisplayItem*>(myParent->child(ii));
-        if ( ch && (ch->getName() == name) )
-            return ch;
+        group->setChild(index, node);
+        entry->nodeIndex = index;
     }
-    return nullptr;
+    else
+    {
+        attachNode(group, entry);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::applyChecked(Entry_t* entry)
+{
+    // lock osg and set the node mask based on the checked state - a group
+    // with a zero mask culls everything under it, so the descendants keep
+    // their own masks and nothing below this entry is touched
+    m_pOsgWidget->lock();
+    entry->node->setNodeMask(entry->checked ? ~0 : 0);
+
+    // show the change, then unlock osg
+    m_pOsgWidget->requestRedraw();
+    m_pOsgWidget->unlock();
+
+    // the descendants are grayed out by the model when they are drawn, so
+    // all the view needs is a repaint
+    viewport()->update();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+size_t TreeView::setVisible(const std::string& pattern,
+                            const bool& visible)
+{
+    if ( nullptr == m_pOsgWidget ) return 0;
+
+    std::vector<Entry_t*> matches;
+
+    m_mutex.lock();
+    Entry_t* top(m_pModel->root()->children.front().get());
+    if ( std::string::npos != pattern.find_first_of("*?[") )
+    {
+        // a glob is matched against every full name
+        matchGlob(pattern, top, "", matches);
+    }
+    else
+    {
+        // a prefix - take the roots of the subtrees starting with the rest of
+        // it, their masks cull everything below them
+        std::string rest;
+        Entry_t* entry( findPrefix(pattern, rest) );
+        if ( nullptr != entry )
+            for ( const auto& child : entry->children )
+                if ( 0 == child->name.compare(0, rest.size(), rest) )
+                    matches.push_back(child.get());
+    }
+
+    // one osg lock for all of them
+    if ( not matches.empty() )
+    {
+        m_pOsgWidget->lock();
+        for ( Entry_t* entry : matches )
+        {
+            entry->checked = visible;
+            entry->node->setNodeMask(visible ? ~0 : 0);
+        }
+        m_pOsgWidget->requestRedraw();
+        m_pOsgWidget->unlock();
+
+        viewport()->update();
+    }
+    m_mutex.unlock();
+
+    return matches.size();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeView::remove(const std::string& name)
+{
+    if ( nullptr == m_pOsgWidget ) return false;
+
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    Entry_t* entry( find(name) );
+    if ( nullptr == entry ) return false;
+
+    return 0 != removeChildren(entry->parent,
+                               [entry](const Entry_t* child) { return child == entry; });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+size_t TreeView::clear(const std::string& prefix)
+{
+    if ( nullptr == m_pOsgWidget ) return 0;
+
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    std::string rest;
+    Entry_t* entry( findPrefix(prefix, rest) );
+    if ( nullptr == entry ) return 0;
+
+    return removeChildren(entry,
+                          [&rest](const Entry_t* child)
+                          {
+                              return 0 == child->name.compare(0, rest.size(), rest);
+                          });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+TreeView::Entry_t* TreeView::findPrefix(const std::string& prefix,
+                                        std::string& rest)
+{
+    static const std::string splitIndicator("::");
+
+    Entry_t* entry(m_pModel->root()->children.front().get());
+    size_t start(0);
+    size_t nameSplit( prefix.find(splitIndicator, start) );
+    while ( (nullptr != entry) && (std::string::npos != nameSplit) )
+    {
+        entry = findChild(entry, prefix.substr(start, nameSplit - start));
+        start = nameSplit + splitIndicator.size();
+        nameSplit = prefix.find(splitIndicator, start);
+    }
+
+    rest = prefix.substr(std::min(start, prefix.size()));
+    return entry;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+size_t TreeView::removeChildren(Entry_t* parent,
+                                const std::function<bool(const Entry_t*)>& which)
+{
+    std::vector<int> rows;
+    for ( const auto& child : parent->children )
+        if ( which(child.get()) )
+            rows.push_back(child->row);
+    if ( rows.empty() ) return 0;
+
+    // take the nodes out of the scene under one osg lock, and forget their
+    // histories
+    std::unordered_set<const osg::Node*> removed;
+    for ( const int& row : rows )
+    {
+        removed.insert(parent->children[row]->node.get());
+        if ( not m_history.empty() ) m_history.forget(fullName(parent->children[row].get()));
+    }
+
+    m_pOsgWidget->lock();
+    detachNodes(parent, removed);
+    m_pOsgWidget->requestRedraw();
+    m_pOsgWidget->unlock();
+
+    // delete the entries, a run of rows at a time from the back so the rows
+    // still to go keep their numbers
+    size_t last(rows.size());
+    while ( last > 0 )
+    {
+        size_t first(last - 1);
+        while ( (first > 0) && (rows[first - 1] + 1 == rows[first]) ) --first;
+        m_pModel->remove(parent, rows[first], rows[last - 1]);
+        last = first;
+    }
+
+    ++m_generation;
+    resizeColumns();
+
+    return rows.size();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::setHistory(const std::string& name,
+                          const size_t& versions)
+{
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    m_history.track(name, versions);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::setHistoryBudget(const size_t& bytes)
+{
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    m_history.setBudget(bytes);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeView::historySpan(History::Time_t& oldest,
+                           History::Time_t& latest)
+{
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    return m_history.span(oldest, latest);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::showTime(const History::Time_t& time)
+{
+    if ( nullptr == m_pOsgWidget ) return;
+
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    m_live = false;
+
+    m_pOsgWidget->lock();
+    for ( const std::string& name : m_history.names() )
+    {
+        Entry_t* entry( find(name) );
+        if ( nullptr != entry ) showVersion(entry, m_history.at(name, time));
+    }
+    m_pOsgWidget->requestRedraw();
+    m_pOsgWidget->unlock();
 };
 
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
-void TreeView::updateChildren(d3DisplayItem* item,
-                                const bool& checked)
+void TreeView::showLive()
 {
-    item->setEnabled(checked);
+    if ( (nullptr == m_pOsgWidget) || m_live ) return;
+
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    m_live = true;
 
-    uint ii(0);
-    while ( true )
+    m_pOsgWidget->lock();
+    for ( const std::string& name : m_history.names() )
     {
-        d3DisplayItem* child( static_cast<d3DisplayItem*>(item->child(ii)) );
-        if ( nullptr == child ) break;
-        if ( Qt::Checked == item->checkState() )
-            updateChildren(child, checked);
-        ++ii;
+        Entry_t* entry( find(name) );
+        if ( nullptr != entry ) showVersion(entry, m_history.latest(name));
     }
+    m_pOsgWidget->requestRedraw();
+    m_pOsgWidget->unlock();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::expire(const std::string& name,
+                      const osg::ref_ptr<osg::Node>& node,
+                      const TimeToLive& ttl)
+{
+    if ( not node ) return;
 
-    if ( checked && Qt::Checked == item->checkState() )
-        item->getNode()->setNodeMask(~0);
+    std::lock_guard<std::recursive_mutex> l_lock(m_mutex);
+    int64_t due(0);
+    if ( TimeToLive::Unit::FRAMES == ttl.unit() )
+    {
+        due = static_cast<int64_t>(m_pOsgWidget->frameCount() + ttl.value());
+        m_expireByFrame.push(Expiry{due, name, node, node.get()});
+        m_pOsgWidget->requestRedraw();
+    }
     else
-        item->getNode()->setNodeMask(0);
+    {
+        const std::chrono::steady_clock::time_point when
+            ( std::chrono::steady_clock::now() +
+              std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(ttl.value())) );
+        due = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+        m_expireByTime.push(Expiry{due, name, node, node.get()});
+    }
+
+    // a later deadline for the same node wins, the earlier entry is skipped
+    m_deadlines[std::make_pair(name, node.get())] = std::make_pair(ttl.unit(), due);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool TreeView::latest(const Expiry& expiry,
+                      const TimeToLive::Unit& unit)
+{
+    const auto deadline( m_deadlines.find(std::make_pair(expiry.name, expiry.address)) );
+    if ( (m_deadlines.end() == deadline) ||
+         (deadline->second != std::make_pair(unit, expiry.due)) ) return false;
+
+    m_deadlines.erase(deadline);
+    return true;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::string TreeView::fullName(const Entry_t* entry)
+{
+    static const std::string splitIndicator("::");
+
+    // up to, but not including, the top level entry
+    std::string name( entry->name );
+    for ( const Entry_t* parent(entry->parent) ;
+          (nullptr != parent) && (nullptr != parent->parent) && (nullptr != parent->parent->parent) ;
+          parent = parent->parent )
+        name = parent->name + splitIndicator + name;
+    return name;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::showVersion(Entry_t* entry,
+                           const osg::ref_ptr<osg::Node>& node)
+{
+    // nothing kept from that far back - show nothing
+    const osg::ref_ptr<osg::Node> shown( node ? node : osg::ref_ptr<osg::Node>(new osg::Group()) );
+    if ( shown == entry->node ) return;
+
+    shown->setNodeMask(entry->node->getNodeMask());
+    swapNode(entry->parent->node->asGroup(), entry, shown);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::expireDue()
+{
+    if ( m_expireByTime.empty() && m_expireByFrame.empty() ) return;
+
+    std::vector<Expiry> due;
+    const int64_t now( std::chrono::duration_cast<std::chrono::nanoseconds>
+                       (std::chrono::steady_clock::now().time_since_epoch()).count() );
+    while ( not m_expireByTime.empty() && (m_expireByTime.top().due <= now) )
+    {
+        if ( latest(m_expireByTime.top(), TimeToLive::Unit::SECONDS) ) due.push_back(m_expireByTime.top());
+        m_expireByTime.pop();
+    }
+
+    const int64_t frame( m_pOsgWidget->frameCount() );
+    while ( not m_expireByFrame.empty() && (m_expireByFrame.top().due <= frame) )
+    {
+        if ( latest(m_expireByFrame.top(), TimeToLive::Unit::FRAMES) ) due.push_back(m_expireByFrame.top());
+        m_expireByFrame.pop();
+    }
+
+    // frames only count once they are drawn, even when rendering on demand
+    if ( not m_expireByFrame.empty() ) m_pOsgWidget->requestRedraw();
+    if ( due.empty() ) return;
+
+    // sort out which names go as a whole, by parent, and which nodes come out
+    // of the group of a name
+    std::unordered_map<Entry_t*, std::unordered_set<const Entry_t*>> entries;
+    std::unordered_map<Entry_t*, std::unordered_set<const osg::Node*>> nodes;
+    for ( const Expiry& expiry : due )
+    {
+        // replaced (and deleted) before its time
+        osg::ref_ptr<osg::Node> node;
+        if ( not expiry.node.lock(node) ) continue;
+
+        Entry_t* entry( find(expiry.name) );
+        if ( nullptr == entry ) continue;
+
+        if ( entry->node == node )               entries[entry->parent].insert(entry);
+        else if ( nullptr != entry->node->asGroup() ) nodes[entry].insert(node.get());
+    }
+
+    if ( not nodes.empty() )
+    {
+        m_pOsgWidget->lock();
+        for ( const auto& owner : nodes )
+            detachNodes(owner.first, owner.second);
+        m_pOsgWidget->requestRedraw();
+        m_pOsgWidget->unlock();
+
+        // a name left with nothing goes too
+        for ( const auto& owner : nodes )
+            if ( (0 == owner.first->node->asGroup()->getNumChildren()) && owner.first->children.empty() )
+                entries[owner.first->parent].insert(owner.first);
+    }
+
+    // deepest first, so no parent is deleted before its turn
+    std::vector<std::pair<size_t, Entry_t*>> parents;
+    for ( const auto& parent : entries )
+    {
+        size_t depth(0);
+        for ( const Entry_t* entry(parent.first) ; nullptr != entry ; entry = entry->parent ) ++depth;
+        parents.emplace_back(depth, parent.first);
+    }
+    std::sort(parents.begin(), parents.end(),
+              [](const std::pair<size_t, Entry_t*>& lhs, const std::pair<size_t, Entry_t*>& rhs)
+              {
+                  return lhs.first > rhs.first;
+              });
+
+    for ( const auto& parent : parents )
+    {
+        const std::unordered_set<const Entry_t*>& which( entries[parent.second] );
+        removeChildren(parent.second,
+                       [&which](const Entry_t* child) { return 0 != which.count(child); });
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::evictWindows()
+{
+    if ( m_windows.empty() ) return;
+
+    // forget the windows that are gone, and age the rest
+    bool evicted(false);
+    m_pOsgWidget->lock();
+    m_windows.erase(std::remove_if(m_windows.begin(), m_windows.end(),
+                                   [&evicted](const osg::observer_ptr<WindowGroup>& window)
+                                   {
+                                       osg::ref_ptr<WindowGroup> group;
+                                       if ( not window.lock(group) ) return true;
+                                       if ( group->evict() ) evicted = true;
+                                       return false;
+                                   }),
+                    m_windows.end());
+    if ( evicted ) m_pOsgWidget->requestRedraw();
+    m_pOsgWidget->unlock();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::detachNodes(Entry_t* owner,
+                           const std::unordered_set<const osg::Node*>& nodes)
+{
+    // a window keeps track of where its nodes are (and releases them)
+    WindowGroup* window( dynamic_cast<WindowGroup*>(owner->node.get()) );
+    if ( nullptr != window )
+    {
+        window->remove(nodes);
+        return;
+    }
+
+    // one pass keeping the rest of the group in order
+    osg::Group* group( owner->node->asGroup() );
+    std::vector<osg::ref_ptr<osg::Node>> kept;
+    kept.reserve(group->getNumChildren());
+    for ( unsigned int ii(0) ; ii<group->getNumChildren() ; ++ii )
+    {
+        osg::Node* child( group->getChild(ii) );
+        if ( 0 == nodes.count(child) ) kept.push_back(child);
+        else                           m_pOsgWidget->release(child);
+    }
+    group->removeChildren(0, group->getNumChildren());
+    for ( const auto& node : kept )
+        group->addChild(node);
+
+    // the children of the entry may have moved down in the group
+    std::unordered_map<const osg::Node*, unsigned int> indices;
+    for ( unsigned int ii(0) ; ii<group->getNumChildren() ; ++ii )
+        indices[group->getChild(ii)] = ii;
+    for ( const auto& child : owner->children )
+    {
+        const auto index( indices.find(child->node.get()) );
+        if ( indices.end() != index ) child->nodeIndex = index->second;
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+std::function<void(const osg::ref_ptr<osg::Node>&)> TreeView::releaser()
+{
+    QOSGWidget* widget( m_pOsgWidget );
+    return [widget](const osg::ref_ptr<osg::Node>& node) { widget->release(node); };
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::matchGlob(const std::string& pattern,
+                         Entry_t* entry,
+                         const std::string& prefix,
+                         std::vector<Entry_t*>& matches)
+{
+    for ( const auto& child : entry->children )
+    {
+        const std::string name( prefix + child->name );
+        if ( 0 == fnmatch(pattern.c_str(), name.c_str(), 0) )
+            matches.push_back(child.get());
+        matchGlob(pattern, child.get(), name + "::", matches);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::setEntryEnabled(Entry_t* entry,
+                               const bool& enabled)
+{
+    if ( enabled == entry->enabled ) return;
+    entry->enabled = enabled;
+    m_pModel->changed(entry);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void TreeView::resizeColumns()
+{
+    m_resizePending = true;
 };
 
 } // namespace d3
@@ -16,13 +16,28 @@
 #include <QtGui/QtGui>
 #include <QtGui/QSplitter>
 
+#include <DDDisplayInterface/Append.h>
+#include <DDDisplayInterface/History.h>
+#include <DDDisplayInterface/TimeToLive.h>
+#include <DDDisplayInterface/TreeModel.h>
+
+#include <osg/Group>
 #include <osg/Node>
+#include <osg/observer_ptr>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace d3
 {
 
 class QOSGWidget;
+class WindowGroup;
 
 /////////////////////////////////////////////////////////////////
 /// @brief   Class to hold the tree view - this makes it useful in other
@@ -37,6 +52,9 @@ class TreeView : public QTreeView
 
   public:
 
+    /// An entry of the tree
+    typedef TreeModel::Entry Entry_t;
+
     /// @brief   Constructor
     TreeView();
 
@@ -56,17 +74,149 @@ class TreeView : public QTreeView
     ///          initially or not
     /// @param   replace If a node with the same "name" already exists, should
     ///          we replace it, or just append it as a group
+    /// @param   merge When appending, let points and lines be merged into the
+    ///          entry's growing buffer (see AppendBuffer) rather than kept as a
+    ///          node of their own
+    bool add(const std::string& name,
+             const osg::ref_ptr<osg::Node> node,
+             const bool& showNode,
+             const bool& replace,
+             const bool& merge = true);
+
+    /// @brief   Append to a name, keeping only a window of the appends
+    /// @param   name The name
+    /// @param   node The node to append
+    /// @param   showNode Should a new entry be shown initially
+    /// @param   window The appends to keep (see Append::Window)
+    ///
+    /// The first windowed append to an existing name makes its node the
+    /// oldest in the window.
     bool add(const std::string& name,
              const osg::ref_ptr<osg::Node> node,
              const bool& showNode,
-             const bool& replace);
+             const Append::Window& window);
+
+    /// @brief   Find the entry of a name
+    /// @param   name The name given to add()
+    /// @return  The entry, null if the name hasn't been added
+    Entry_t* find(const std::string& name);
+
+    /// @brief   Add to the entry of an earlier add, without looking up a name
+    /// @param   item The entry from find()
+    /// @param   node The node to add
+    /// @param   replace Replace the entry's node or append to it
+    /// @param   merge When appending, let points and lines be merged
+    bool add(Entry_t* item,
+             const osg::ref_ptr<osg::Node> node,
+             const bool& replace,
+             const bool& merge = true);
+
+    /// @{
+    /// @name    Group several adds into one tree view update
+    ///
+    /// Between beginUpdate() and the matching endUpdate() the view does not
+    /// repaint. Calls may be nested.
+    void beginUpdate();
+    void endUpdate();
+    /// @}
+
+    /// @brief   Show or hide many entries at once
+    /// @param   pattern A glob ('*', '?' or '[') matched against the full
+    ///          names, or else a prefix of the full names
+    /// @param   visible Show or hide them
+    /// @return  size_t The number of entries changed
+    ///
+    /// Everything is done under a single lock of the display. A prefix only
+    /// changes the entries it names, not their descendants - like unchecking
+    /// a row, hiding an entry hides everything under it, and showing it again
+    /// brings back what was shown before.
+    size_t setVisible(const std::string& pattern,
+                      const bool& visible);
+
+    /// @brief   Remove an entry and everything below it
+    /// @param   name The full name given to add()
+    /// @return  boolean True if there was such an entry
+    ///
+    /// The nodes are taken out of the scene and handed to the osg widget,
+    /// which deletes their GL objects on the next frame.
+    bool remove(const std::string& name);
+
+    /// @brief   Remove every entry whose full name starts with a prefix
+    /// @param   prefix The prefix (empty removes everything)
+    /// @return  size_t The number of top level entries removed
+    size_t clear(const std::string& prefix);
+
+    /// @brief   Add a node that is taken out of the display again once its
+    ///          time is up
+    /// @param   name The name (same convention as add())
+    /// @param   node The node
+    /// @param   showNode Show it
+    /// @param   replace Replace the node of the name or append to it (never
+    ///          merged into a buffer, where it couldn't be found again)
+    /// @param   ttl How long it stays from now
+    /// @return  boolean True if it was added
+    ///
+    /// Only the node goes - the other nodes appended to the name stay, and the
+    /// name goes from the tree once nothing is left under it. Nothing happens
+    /// if the node has been replaced in the meantime. The time is kept for the
+    /// node that went into the tree, which with a history can be a kept
+    /// version equal to this one, and adding it again starts its time over.
+    bool add(const std::string& name,
+             const osg::ref_ptr<osg::Node> node,
+             const bool& showNode,
+             const bool& replace,
+             const TimeToLive& ttl);
+
+    /// @brief   Keep the versions replaced under a name to scrub back through
+    /// @param   name The name (and the names under it)
+    /// @param   versions The most versions kept of each (0 stops)
+    void setHistory(const std::string& name,
+                    const size_t& versions);
+
+    /// @brief   Set the most bytes of geometry kept by all the histories
+    void setHistoryBudget(const size_t& bytes);
+
+    /// @brief   The times of the oldest and latest versions kept
+    /// @return  boolean False if no versions are kept
+    bool historySpan(History::Time_t& oldest,
+                     History::Time_t& latest);
+
+    /// @brief   Show every name with a history as it was at a time
+    /// @param   time The time
+    ///
+    /// Until showLive(), replacing a name with a history only adds a version
+    /// and the shown version stays.
+    void showTime(const History::Time_t& time);
+
+    /// @brief   Show the latest version of every name with a history again
+    void showLive();
+
+    /// @brief   Are the latest versions being shown
+    bool live() const { return m_live; };
+
+    /// @brief   Counts the removals, so entries remembered from before one
+    ///          can be recognized as possibly gone
+    uint64_t generation() const { return m_generation; };
+
+    /// @brief   Is anything waiting on the clock (time to live or a time
+    ///          window), so refresh() must keep being called
+    bool timed();
+
+    /// @brief   Bring the view up to date - called once per frame
+    ///
+    /// Takes out the nodes whose time is up, hands the rows added since the
+    /// last frame to the view (one insert per parent) and re-measures the
+    /// column if anything changed its width, so a flood of adds costs the view
+    /// one update per frame.
+    void refresh();
 
   public Q_SLOTS:
 
     /// @brief   Method to call when the frame is clicked
     void clicked(const QModelIndex& index);
 
-    /// @brief   Method to reset the column width when something is expanded
+    /// @brief   Method to fetch the children and reset the column width when
+    ///          something is expanded
     void expanded(const QModelIndex& index);
     
     /// @brief   Method to reset the column width when something is collapsed
@@ -74,46 +224,34 @@ class TreeView : public QTreeView
 
   private:
 
-    /////////////////////////////////////////////////////////////////
-    /// @brief   Override the standard qitem for the tree view so we can hold an
-    ///          osg node and name of the item
-    /////////////////////////////////////////////////////////////////
-    class d3DisplayItem : public QStandardItem
+    /// A node to take out once its time is up
+    struct Expiry
     {
-      public:
-        /// @brief   Construct with a name and node
-        /// @param   name The name of the node
-        /// @param   node The node to add to this item
-        d3DisplayItem(const std::string& name,
-                      const osg::ref_ptr<osg::Node> node) :
-            QStandardItem(QString(name.c_str())),
-            m_name(name),
-            m_node(node)
-        {
-            setEditable(true);
-            setCheckable(true);
-            setCheckState(Qt::Checked);
-        };
-
-        /// @brief   The destructor
-        virtual ~d3DisplayItem() {};
-
-        /// @{
-        /// @brief   Accessors
-        const std::string& getName() const { return m_name; };
-        const osg::ref_ptr<osg::Node> getNode()  { return m_node; };
-        void setNode(osg::ref_ptr<osg::Node> node) { m_node = node; };
-        /// @}
-
-      private:
-
-        /// The name
-        std::string                 m_name;
-
-        /// The node
-        osg::ref_ptr<osg::Node>     m_node;
+        /// When - steady clock nanoseconds or a frame count
+        int64_t                      due;
+
+        /// The name it was added with
+        std::string                  name;
+
+        /// The node (not kept alive just to be expired)
+        osg::observer_ptr<osg::Node> node;
+
+        /// Where the node was, to find its latest deadline (never
+        /// dereferenced)
+        const osg::Node*             address;
+
+        /// Order the heaps soonest first
+        bool operator>(const Expiry& other) const { return due > other.due; };
     };
 
+    /// The expiries, soonest on top
+    typedef std::priority_queue<Expiry, std::vector<Expiry>, std::greater<Expiry>> Expiries_t;
+
+    /// The latest deadline of each name and node - an expiry popped from a
+    /// heap only counts if it is still the latest
+    typedef std::map<std::pair<std::string, const osg::Node*>,
+                     std::pair<TimeToLive::Unit, int64_t>> Deadlines_t;
+
     /// @brief   Internal ethod to add an object to the osg display
     /// @param   name The name to use in the model view
     /// @param   node The node to display
@@ -121,13 +259,15 @@ class TreeView : public QTreeView
     /// @param   showNode Should the node be displayed or not (checked or not?)
     /// @param   replace Should we append or overwrite an existing node with the
     ///          same name?
+    /// @param   merge May an appended node be merged into a buffer
     /// @param   myParent The parent so we can call this recursively
     bool add(const std::string& name,
              const osg::ref_ptr<osg::Node> node,
              const bool& enableNode,
              const bool& showNode,
              const bool& replace,
-             d3DisplayItem* myParent);
+             const bool& merge,
+             Entry_t* myParent);
 
     /// @brief   Create a new entry in the model view
     /// @param   name The name to use in the model view
@@ -139,7 +279,7 @@ class TreeView : public QTreeView
                         const osg::ref_ptr<osg::Node> node,
                         const bool& enableNode,
                         const bool& showNode,
-                        d3DisplayItem* myParent);
+                        Entry_t* myParent);
 
     /// @brief   Method to add to an existing entry
     /// @param   entry The entry to add to
@@ -147,32 +287,36 @@ class TreeView : public QTreeView
     /// @param   enableNode Should the entry be enabled (grayed out or not?)
     /// @param   replace Should we append or overwrite an existing node with the
     ///          same name?
+    /// @param   merge May an appended node be merged into a buffer
     /// @param   myParent The parent so we can call this recursively
-    bool addToEntry(d3DisplayItem* entry,
+    bool addToEntry(Entry_t* entry,
                     const osg::ref_ptr<osg::Node> node,
                     const bool& enableNode,
                     const bool& replace,
-                    d3DisplayItem* myParent);
+                    const bool& merge,
+                    Entry_t* myParent);
 
     /// @brief   Method to replace a node
     /// @param   entry The entry to add to
     /// @param   node The node to display
     /// @param   enableNode Should the entry be enabled (grayed out or not?)
     /// @param   myParent The parent so we can call this recursively
-    bool replaceNode(d3DisplayItem* entry,
+    bool replaceNode(Entry_t* entry,
                      const osg::ref_ptr<osg::Node> node,
                      const bool& enableNode,
-                     d3DisplayItem* myParent);
+                     Entry_t* myParent);
 
     /// @brief   Method to append to a node
     /// @param   entry The entry to add to
     /// @param   node The node to display
     /// @param   enableNode Should the entry be enabled (grayed out or not?)
+    /// @param   merge May the node be merged into the entry's growing buffer
     /// @param   myParent The parent so we can call this recursively
-    bool appendNode(d3DisplayItem* entry,
+    bool appendNode(Entry_t* entry,
                     const osg::ref_ptr<osg::Node> node,
                     const bool& enableNode,
-                    d3DisplayItem* myParent);
+                    const bool& merge,
+                    Entry_t* myParent);
 
     /// @brief   Place to add the parent
     /// @param   parentName The name of the parent to add
@@ -181,6 +325,7 @@ class TreeView : public QTreeView
     /// @param   enableNode The enableNode flag (recursion)
     /// @param   showNode The showNode flag (recursion)
     /// @param   replace The replace flag (recursion)
+    /// @param   merge The merge flag (recursion)
     /// @parem   myParent The parent node to add this parent to
     bool addParent(const std::string& parentName,
                    const std::string& childName,
@@ -188,24 +333,144 @@ class TreeView : public QTreeView
                    const bool& enableNode,
                    const bool& showNode,
                    const bool& replace,
-                   d3DisplayItem* myParent);
+                   const bool& merge,
+                   Entry_t* myParent);
 
     /// @brief   Method to find and return a pointer to the child of parent with name
-    static d3DisplayItem* findChild(const d3DisplayItem* myParent,
-                                    const std::string& name);
-
-    /// @brief
-    static void updateChildren(d3DisplayItem* item,
-                               const bool& checked);
+    static Entry_t* findChild(const Entry_t* myParent,
+                              const std::string& name);
+
+    /// @brief   Add the node of an entry to its parent's group
+    /// @param   group The parent's group
+    /// @param   entry The entry
+    static void attachNode(osg::Group* group,
+                           Entry_t* entry);
+
+    /// @brief   Swap the node of an entry in its parent's group, in place
+    /// @param   group The parent's group
+    /// @param   entry The entry
+    /// @param   node The new node for the entry
+    static void swapNode(osg::Group* group,
+                         Entry_t* entry,
+                         const osg::ref_ptr<osg::Node>& node);
+
+    /// @brief   Set the node masks of an entry and its children from the
+    ///          checkboxes
+    /// @param   entry The entry that was checked or unchecked
+    void applyChecked(Entry_t* entry);
+
+    /// @brief   Walk down the complete levels of a prefix
+    /// @param   prefix The prefix
+    /// @param   rest Set to what is left of the prefix after the last "::"
+    /// @return  The entry of the last complete level, null if it doesn't exist
+    Entry_t* findPrefix(const std::string& prefix,
+                        std::string& rest);
+
+    /// @brief   The full name of an entry (as given to add())
+    static std::string fullName(const Entry_t* entry);
+
+    /// @brief   Put a version of a name in the scene
+    /// @param   entry The entry of the name
+    /// @param   node The version (null shows nothing)
+    void showVersion(Entry_t* entry,
+                     const osg::ref_ptr<osg::Node>& node);
+
+    /// @brief   Take out the nodes whose time is up
+    void expireDue();
+
+    /// @brief   Take a node out of the display again once its time is up
+    /// @param   name The name it was added with
+    /// @param   node The node in the tree
+    /// @param   ttl How long it stays from now
+    void expire(const std::string& name,
+                const osg::ref_ptr<osg::Node>& node,
+                const TimeToLive& ttl);
+
+    /// @brief   Is an expiry popped from a heap still the latest deadline of
+    ///          its node (and if so, forget the deadline)
+    /// @param   expiry The expiry
+    /// @param   unit The unit of the heap it came from
+    bool latest(const Expiry& expiry,
+                const TimeToLive::Unit& unit);
+
+    /// @brief   Evict what has fallen out of the windows in seconds
+    void evictWindows();
+
+    /// @brief   Take nodes out of the group of an entry and release them
+    /// @param   owner The entry
+    /// @param   nodes The nodes to take out
+    /// @note    Call with the osg lock held
+    void detachNodes(Entry_t* owner,
+                     const std::unordered_set<const osg::Node*>& nodes);
+
+    /// @brief   What a window group calls with the nodes it takes out - hands
+    ///          them to the osg widget to free their GL objects
+    std::function<void(const osg::ref_ptr<osg::Node>&)> releaser();
+
+    /// @brief   Remove children of an entry, with everything below them
+    /// @param   parent The entry
+    /// @param   which Selects the children to remove
+    /// @return  size_t The number of children removed
+    size_t removeChildren(Entry_t* parent,
+                          const std::function<bool(const Entry_t*)>& which);
+
+    /// @brief   Find the entries whose full name matches a glob
+    /// @param   pattern The glob
+    /// @param   entry Where to look below
+    /// @param   prefix The full name of entry followed by "::" (empty for the
+    ///          top)
+    /// @param   matches Where the matches go
+    static void matchGlob(const std::string& pattern,
+                          Entry_t* entry,
+                          const std::string& prefix,
+                          std::vector<Entry_t*>& matches);
+
+    /// @brief   Set if an entry is enabled (grayed out or not)
+    void setEntryEnabled(Entry_t* entry,
+                         const bool& enabled);
+
+    /// @brief   Note that the column needs to be resized on the next refresh()
+    void resizeColumns();
 
     /// The osg widget
     QOSGWidget*               m_pOsgWidget;
 
     /// The tree model
-    QStandardItemModel*       m_pModel;
+    TreeModel*                m_pModel;
 
     /// The model protection
     std::recursive_mutex      m_mutex;
+
+    /// Nesting depth of beginUpdate()
+    unsigned int              m_updateDepth;
+
+    /// The column needs to be resized on the next refresh()
+    bool                      m_resizePending;
+
+    /// The number of removals so far
+    uint64_t                  m_generation;
+
+    /// The nodes living for a time
+    Expiries_t                m_expireByTime;
+
+    /// The nodes living for a number of frames
+    Expiries_t                m_expireByFrame;
+
+    /// The latest deadline of each node in the heaps
+    Deadlines_t               m_deadlines;
+
+    /// The node the last add put in the tree (the kept version if a history
+    /// shared an older, equal one) - for the add with a time to live
+    osg::ref_ptr<osg::Node>   m_added;
+
+    /// The windowed groups, to age them every frame
+    std::vector<osg::observer_ptr<WindowGroup>> m_windows;
+
+    /// The versions of the names with a history
+    History                   m_history;
+
+    /// Are the latest versions shown (or some time from the history)
+    bool                      m_live;
 };
 
 } // namespace d3
@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////
+/// @file      WindowGroup.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     A group holding only the most recent of the nodes appended to it
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "WindowGroup.h"
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+WindowGroup::WindowGroup(const Append::Window& window,
+                         const Release_t& release) :
+    osg::Group(),
+    m_window(window),
+    m_items(),
+    m_slots(),
+    m_release(release)
+{
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+WindowGroup::~WindowGroup()
+{
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void WindowGroup::append(const osg::ref_ptr<osg::Node>& node)
+{
+    // the same node twice would have two slots
+    if ( not node || (0 != m_slots.count(node.get())) ) return;
+
+    m_slots[node.get()] = getNumChildren();
+    addChild(node);
+    m_items.push_back(Item{std::chrono::steady_clock::now(), node});
+
+    evict();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+bool WindowGroup::evict()
+{
+    const size_t before( m_items.size() );
+
+    if ( 0 != m_window.count )
+        while ( m_items.size() > m_window.count )
+            evictOldest();
+
+    if ( m_window.seconds > 0.0 )
+    {
+        const std::chrono::steady_clock::time_point oldest
+            ( std::chrono::steady_clock::now() -
+              std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(m_window.seconds)) );
+        while ( not m_items.empty() && (m_items.front().time < oldest) )
+            evictOldest();
+    }
+
+    return before != m_items.size();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void WindowGroup::remove(const std::unordered_set<const osg::Node*>& nodes)
+{
+    for ( auto item(m_items.begin()) ; item != m_items.end() ; )
+    {
+        if ( 0 == nodes.count(item->node.get()) )
+        {
+            ++item;
+            continue;
+        }
+
+        takeOut(item->node);
+        item = m_items.erase(item);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+//////// PRIVATES //////////////////////////////////////////////
+///////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void WindowGroup::evictOldest()
+{
+    const Item oldest( m_items.front() );
+    m_items.pop_front();
+    takeOut(oldest.node);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void WindowGroup::takeOut(const osg::ref_ptr<osg::Node>& node)
+{
+    const auto slot( m_slots.find(node.get()) );
+    if ( m_slots.end() == slot ) return;
+    unsigned int index( slot->second );
+    m_slots.erase(slot);
+    if ( m_release ) m_release(node);
+
+    // the remembered slot is right unless someone changed the group behind
+    // our back, only then do we have to search for it
+    if ( (index >= getNumChildren()) || (getChild(index) != node.get()) )
+        index = getChildIndex(node.get());
+    if ( index >= getNumChildren() ) return;
+
+    // move the last child into the hole and drop the back
+    const unsigned int last( getNumChildren() - 1 );
+    if ( index != last )
+    {
+        osg::Node* moved( getChild(last) );
+        setChild(index, moved);
+
+        const auto movedSlot( m_slots.find(moved) );
+        if ( m_slots.end() != movedSlot ) movedSlot->second = index;
+    }
+    removeChildren(last, 1);
+};
+
+} // namespace d3
@@ -0,0 +1,111 @@
+/////////////////////////////////////////////////////////////////
+/// @file      WindowGroup.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     A group holding only the most recent of the nodes appended to it
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <DDDisplayInterface/Append.h>
+
+#include <osg/Group>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace d3
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A group that keeps a rolling window of appended nodes
+///
+/// The nodes are kept oldest first in a queue beside the group. Evicting the
+/// oldest moves the last child into its place and pops the back of the group,
+/// so an eviction never shifts the other children no matter how large the
+/// window is. The order of the children is not the order of the appends.
+///
+/// Only append() and remove() may change the children - adding to the group
+/// directly bypasses the window, and what is added that way is never evicted.
+/////////////////////////////////////////////////////////////////
+class WindowGroup : public osg::Group
+{
+  public:
+
+    /// Called with each node taken out of the group (to free its GL objects)
+    typedef std::function<void(const osg::ref_ptr<osg::Node>&)> Release_t;
+
+    /// @brief   Constructor
+    /// @param   window The appends to keep
+    /// @param   release Called with each node evicted or removed
+    WindowGroup(const Append::Window& window,
+                const Release_t& release);
+
+    /// @{
+    /// @name    Get and set the appends to keep (a smaller window takes effect
+    ///          with the next append() or evict())
+    const Append::Window& getWindow() const { return m_window; };
+    void setWindow(const Append::Window& window) { m_window = window; };
+    /// @}
+
+    /// @brief   Append a node, evicting what falls out of the window
+    /// @param   node The node
+    void append(const osg::ref_ptr<osg::Node>& node);
+
+    /// @brief   Take nodes out before they fall out of the window (e.g. when
+    ///          their time to live is up)
+    /// @param   nodes The nodes (those not in the group are ignored)
+    void remove(const std::unordered_set<const osg::Node*>& nodes);
+
+    /// @brief   Evict what falls out of the window
+    /// @return  boolean True if anything was evicted
+    ///
+    /// A window in seconds shrinks without appends too, so this is called once
+    /// per frame.
+    bool evict();
+
+  protected:
+
+    /// @brief   Destructor
+    virtual ~WindowGroup();
+
+  private:
+
+    /// An appended node
+    struct Item
+    {
+        /// When it was appended
+        std::chrono::steady_clock::time_point time;
+
+        /// The node
+        osg::ref_ptr<osg::Node>               node;
+    };
+
+    /// @brief   Take the oldest node out of the group
+    void evictOldest();
+
+    /// @brief   Take an appended node out of the group and release it
+    /// @param   node The node (still held by its item)
+    void takeOut(const osg::ref_ptr<osg::Node>& node);
+
+    /// The appends to keep
+    Append::Window                                     m_window;
+
+    /// The appended nodes, oldest first
+    std::deque<Item>                                   m_items;
+
+    /// Where each appended node is in the group (the items keep the nodes
+    /// alive, so an address is never reused while it is here)
+    std::unordered_map<const osg::Node*, unsigned int> m_slots;
+
+    /// Called with each node taken out
+    Release_t                                          m_release;
+};
+
+} // namespace d3
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/MatrixTransform>
 #include <osg/Image>
 
@@ -39,7 +41,7 @@ struct CameraImage
 typedef std::vector<CameraImage> CameraImageVec_t;
 
 /// The get for the vector
-osg::ref_ptr<osg::Node> get(const CameraImageVec_t& images);
+D3_DECL(osg::ref_ptr<osg::Node> get(const CameraImageVec_t& images))
 
 /// The get for a single image
 inline osg::ref_ptr<osg::Node> get(const CameraImage& image)
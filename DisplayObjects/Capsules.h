@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Vec3>
 #include <osg/Vec4>
 #include <osg/Node>
@@ -41,7 +43,7 @@ typedef std::vector<Capsule> CapsuleVec_t;
 /// @brief   Create an osg::Node from a vector of capsules
 /// @param   capsules The vector of capsules to create the node from
 /// @return  osg::ref_ptr<osg::Node> The displayable node
-osg::ref_ptr<osg::Node> get(const CapsuleVec_t& capsules);
+D3_DECL(osg::ref_ptr<osg::Node> get(const CapsuleVec_t& capsules))
 
 /// @brief   Create an osg::Node from a single capsule
 /// @param   capsule The capsule to create the node from
@@ -10,6 +10,8 @@
 
 #include "Colors.h"
 
+#include <algorithm>
+
 namespace d3
 {
 
@@ -186,4 +188,15 @@ unsigned int toIndex(const double rr,
                + static_cast<unsigned int>(bb*255.0)*256)*256);
 };
 
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::Vec4ub toBytes(const osg::Vec4& color)
+{
+    auto toByte = [](const float& value) -> unsigned char
+        {
+            return static_cast<unsigned char>(std::min(1.0f, std::max(0.0f, value))*255.0f + 0.5f);
+        };
+    return osg::Vec4ub(toByte(color.r()), toByte(color.g()), toByte(color.b()), toByte(color.a()));
+};
+
 } // namespace d3
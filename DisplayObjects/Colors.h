@@ -10,7 +10,10 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Vec4>
+#include <osg/Vec4ub>
 #include <vector>
 
 namespace d3
@@ -52,28 +55,44 @@ class Colors
 /// @brief   Provide a method to get the next color in a static sense
 inline osg::Vec4 nextColor()
 {
+#ifdef   D3_DISABLE
+    return detail::noColor();
+#else    // D3_DISABLE
     static Colors colors;
     return colors.next();
+#endif   // D3_DISABLE
 };
 
+#ifdef   D3_DISABLE
+/// The color stubs have nothing to refer to, so they hand back copies
+typedef osg::Vec4 NamedColor_t;
+#else    // D3_DISABLE
+/// The named colors are references to the colors held by the library
+typedef const osg::Vec4& NamedColor_t;
+#endif   // D3_DISABLE
+
 /// @{
 /// @name    Some standard colors by name
-const osg::Vec4& black();
-const osg::Vec4& white();
+D3_STUB(detail::noColor(), NamedColor_t black())
+D3_STUB(detail::noColor(), NamedColor_t white())
 
-const osg::Vec4& red();
-const osg::Vec4& green();
-const osg::Vec4& blue();
+D3_STUB(detail::noColor(), NamedColor_t red())
+D3_STUB(detail::noColor(), NamedColor_t green())
+D3_STUB(detail::noColor(), NamedColor_t blue())
 
-const osg::Vec4& yellow();
-const osg::Vec4& magenta();
-const osg::Vec4& cyan();
+D3_STUB(detail::noColor(), NamedColor_t yellow())
+D3_STUB(detail::noColor(), NamedColor_t magenta())
+D3_STUB(detail::noColor(), NamedColor_t cyan())
 /// @}
 
 /// @brief    change an rgb color to an index
-unsigned int toIndex(const double rr,
-                     const double gg,
-                     const double bb);
+D3_STUB(0, unsigned int toIndex(const double rr,
+                                const double gg,
+                                const double bb))
+
+/// @brief   A color as four normalized bytes (clamped to [0,1] first), the way
+///          the display objects hand colors to GL
+D3_STUB(osg::Vec4ub(255, 255, 255, 255), osg::Vec4ub toBytes(const osg::Vec4& color))
 
 } // namespace d3
 
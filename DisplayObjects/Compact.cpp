@@ -0,0 +1,114 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Compact.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     The compact vertex format shared by the display objects
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "Compact.h"
+
+#include <osg/Version>
+
+#include <algorithm>
+#include <limits>
+
+namespace d3
+{
+
+namespace
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A bound known up front, good until the vertices change
+/////////////////////////////////////////////////////////////////
+class KnownBound : public osg::Drawable::ComputeBoundingBoxCallback
+{
+  public:
+
+    /// @brief   Constructor
+    /// @param   bound The bound
+    /// @param   modified The modified count of the vertices it is of
+    KnownBound(const osg::BoundingBox& bound,
+               const unsigned int& modified) :
+        osg::Drawable::ComputeBoundingBoxCallback(),
+        m_bound(bound),
+        m_modified(modified)
+    {
+    };
+
+    /// @brief   The bound, computed by osg once the vertices are dirtied
+    virtual osg::BoundingBox computeBound(const osg::Drawable& drawable) const
+    {
+        const osg::Geometry* geometry( drawable.asGeometry() );
+        const osg::Array* vertices( (nullptr == geometry) ? nullptr : geometry->getVertexArray() );
+        if ( (nullptr != vertices) && (vertices->getModifiedCount() == m_modified) ) return m_bound;
+#if      OSG_MIN_VERSION_REQUIRED(3,4,0)
+        return drawable.computeBoundingBox();
+#else    // OSG_MIN_VERSION_REQUIRED(3,4,0)
+        return drawable.computeBound();
+#endif   // OSG_MIN_VERSION_REQUIRED(3,4,0)
+    };
+
+  private:
+
+    /// The bound
+    osg::BoundingBox m_bound;
+
+    /// The modified count of the vertices when it was found
+    unsigned int     m_modified;
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void setCompactColors(osg::Geometry* geometry,
+                      const osg::ref_ptr<osg::Vec4ubArray>& colors)
+{
+    // a single color is kept once
+    const bool overall( not colors->empty() &&
+                        (colors->end() == std::find_if(colors->begin(), colors->end(),
+                                                       [&](const osg::Vec4ub& color) { return color != colors->front(); })) );
+    if ( overall ) colors->resize(1);
+
+    colors->setNormalize(true);
+#if      OSG_MIN_VERSION_REQUIRED(3,2,0)
+    geometry->setColorArray(colors, overall ? osg::Array::Binding::BIND_OVERALL : osg::Array::Binding::BIND_PER_VERTEX);
+#else    // OSG_MIN_VERSION_REQUIRED(3,2,0)
+    geometry->setColorArray(colors);
+    geometry->setColorBinding(overall ? osg::Geometry::BIND_OVERALL : osg::Geometry::BIND_PER_VERTEX);
+#endif   // OSG_MIN_VERSION_REQUIRED(3,2,0)
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void setKnownBound(osg::Geometry* geometry,
+                   const osg::BoundingBox& bound)
+{
+    const osg::Array* vertices( geometry->getVertexArray() );
+    if ( nullptr == vertices ) return;
+    geometry->setComputeBoundingBoxCallback(new KnownBound(bound, vertices->getModifiedCount()));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::PrimitiveSet> drawInOrder(const GLenum& mode,
+                                            const size_t& count)
+{
+    return new osg::DrawArrays(mode, 0, static_cast<GLsizei>(count));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::DrawElements> drawIndexed(const GLenum& mode,
+                                            const size_t& numVertices)
+{
+    if ( numVertices <= std::numeric_limits<GLubyte>::max() )  return new osg::DrawElementsUByte(mode);
+    if ( numVertices <= std::numeric_limits<GLushort>::max() ) return new osg::DrawElementsUShort(mode);
+    return new osg::DrawElementsUInt(mode);
+};
+
+} // namespace d3
@@ -0,0 +1,54 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Compact.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     The compact vertex format shared by the display objects
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Disable.h"
+
+#include <osg/Array>
+#include <osg/BoundingBox>
+#include <osg/Geometry>
+
+namespace d3
+{
+
+/// @brief   Give a geometry its colors in the compact format
+/// @param   geometry The geometry
+/// @param   colors The color of each vertex (see toBytes())
+///
+/// The colors are normalized bytes rather than floats, 4 bytes a vertex
+/// instead of 16, and when they are all the same only the one color is kept
+/// and bound overall.
+D3_STUB(void(), void setCompactColors(osg::Geometry* geometry,
+                                      const osg::ref_ptr<osg::Vec4ubArray>& colors))
+
+/// @brief   Give a geometry the bound found while filling its vertices
+/// @param   geometry The geometry (with its vertex array set)
+/// @param   bound The bound of the vertices
+///
+/// osg would otherwise walk every vertex again for it. The bound is used
+/// until the vertex array is dirtied, then osg computes it as usual.
+D3_STUB(void(), void setKnownBound(osg::Geometry* geometry,
+                                   const osg::BoundingBox& bound))
+
+/// @brief   The primitives drawing a run of vertices in order - no indices
+/// @param   mode The primitive mode (POINTS, LINES, ...)
+/// @param   count The number of vertices
+D3_STUB(nullptr, osg::ref_ptr<osg::PrimitiveSet> drawInOrder(const GLenum& mode,
+                                                             const size_t& count))
+
+/// @brief   The smallest index type holding the indices of some vertices
+/// @param   mode The primitive mode (QUADS, TRIANGLES, ...)
+/// @param   numVertices The number of vertices indexed
+/// @return  A DrawElementsUByte, UShort or UInt
+D3_STUB(nullptr, osg::ref_ptr<osg::DrawElements> drawIndexed(const GLenum& mode,
+                                                             const size_t& numVertices))
+
+} // namespace d3
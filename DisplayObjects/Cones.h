@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Vec3>
 #include <osg/Vec4>
 #include <osg/Node>
@@ -41,7 +43,7 @@ typedef std::vector<Cone> ConeVec_t;
 /// @brief   Create an osg::Node from a vector of cones
 /// @param   cones The vector of cones to create the node from
 /// @return  osg::ref_ptr<osg::Node> The displayable node
-osg::ref_ptr<osg::Node> get(const ConeVec_t& cones);
+D3_DECL(osg::ref_ptr<osg::Node> get(const ConeVec_t& cones))
 
 /// @brief   Create an osg::Node from a single cone
 /// @param   cone The cone to create the node from
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Vec3>
 #include <osg/Vec4>
 #include <osg/Node>
@@ -41,7 +43,7 @@ typedef std::vector<Cylinder> CylinderVec_t;
 /// @brief   Create an osg::Node from a vector of cylinders
 /// @param   cylinders The vector of Cylinders to create the node from
 /// @return  osg::ref_ptr<osg::Node> The displayable node
-osg::ref_ptr<osg::Node> get(const CylinderVec_t& cylinders);
+D3_DECL(osg::ref_ptr<osg::Node> get(const CylinderVec_t& cylinders))
 
 /// @brief   Create an osg::Node from a single cylinder
 /// @param   cylinder The Cylinder to create the node from
@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Disable.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Compile out the developer debug display
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/// @def     D3(...)
+/// @brief   Wrap debug display statements so they can be compiled out
+///
+/// Build with -DD3_DISABLE and everything inside D3() disappears, including
+/// the evaluation of the arguments - so the work of filling a PointVec_t for
+/// display costs nothing in a release build:
+/// @code
+/// D3( d3::PointVec_t cloud;
+///     for ( const auto& pt : scan ) cloud.push_back(d3::Point{pt, d3::white()});
+///     d3::di().add("scan", d3::get(cloud)); );
+/// @endcode
+/// Without D3_DISABLE the statements are compiled as they are.
+///
+/// Calls that aren't wrapped still compile with D3_DISABLE, against header only
+/// stubs (see DisplayInterfaceStub.h and D3_DECL below) so nothing needs to be
+/// linked, but their arguments are evaluated.
+
+/// @def     D3_DECL(...)
+/// @brief   Declare a function returning a node - with D3_DISABLE it becomes an
+///          inline stub returning null
+
+/// @def     D3_STUB(value, ...)
+/// @brief   Declare a function - with D3_DISABLE it becomes an inline stub
+///          returning value
+
+#ifdef   D3_DISABLE
+
+#define D3(...) ((void)0)
+#define D3_STUB(value, ...) inline __VA_ARGS__ { return value; }
+#define D3_DECL(...) D3_STUB(nullptr, __VA_ARGS__)
+
+#include <osg/Vec4>
+
+namespace d3
+{
+namespace detail
+{
+/// @brief   What the color stubs hand back - a copy, since a static would
+///          be kept (with its guard) by every caller
+inline osg::Vec4 noColor()
+{
+    return osg::Vec4(1.0, 1.0, 1.0, 1.0);
+}
+} // namespace detail
+} // namespace d3
+
+#else    // D3_DISABLE
+
+#define D3(...) __VA_ARGS__
+#define D3_STUB(value, ...) __VA_ARGS__;
+#define D3_DECL(...) __VA_ARGS__;
+
+#endif   // D3_DISABLE
@@ -8,48 +8,77 @@
 /// @attention All rights reserved
 /////////////////////////////////////////////////////////////////
 
+#include "Colors.h"
 #include "Grids.h"
 #include "Lines.h"
 
 #include <osg/Geometry>
 
+#include <vector>
+
 namespace d3
 {
 
+namespace
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Walk the lines of a grid
+/// @param   grid The grid
+/// @param   line Called with the beginning and end of each line
+///
+/// Both the count and the fill walk the lines here, so they can't disagree on
+/// how many there are.
+/////////////////////////////////////////////////////////////////
+template<typename Line_t>
+void eachLine(const Grid& grid,
+              const Line_t& line)
+{
+    for ( double xx(-grid.halfSpan.x());
+          xx<=grid.halfSpan.x();
+          xx+=grid.spacing.x() )
+    {
+        line(osg::Vec3f(xx, -grid.halfSpan.y(), 0.0),
+             osg::Vec3f(xx,  grid.halfSpan.y(), 0.0));
+    }
+
+    for ( double yy(-grid.halfSpan.y());
+          yy<=grid.halfSpan.y();
+          yy+=grid.spacing.y() )
+    {
+        line(osg::Vec3f(-grid.halfSpan.x(), yy, 0.0),
+             osg::Vec3f( grid.halfSpan.x(), yy, 0.0));
+    }
+};
+
+} // namespace
+
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 osg::ref_ptr<osg::Node> get(const GridVec_t& grids)
 {
-    LineVec_t lines;
+    // count the lines first, so the arrays are sized once
+    size_t numLines(0);
+    for ( const auto& grid : grids )
+        eachLine(grid, [&](const osg::Vec3f&, const osg::Vec3f&) { ++numLines; });
 
+    // then the ends and colors go straight into the arrays handed to GL
+    std::vector<osg::Vec3f> ends(2*numLines);
+    std::vector<osg::Vec4ub> colors(2*numLines);
+    size_t end(0);
     for ( const auto& grid : grids )
     {
-        for ( double xx(-grid.halfSpan.x());
-              xx<=grid.halfSpan.x();
-              xx+=grid.spacing.x() )
-        {
-            lines.push_back
-                ({
-                    osg::Vec3d(xx, -grid.halfSpan.y(), 0.0),
-                    osg::Vec3d(xx,  grid.halfSpan.y(), 0.0),
-                    grid.color
-                });
-        }
-
-        for ( double yy(-grid.halfSpan.y());
-              yy<=grid.halfSpan.y();
-              yy+=grid.spacing.y() )
-        {
-            lines.push_back
-                ({
-                    osg::Vec3d(-grid.halfSpan.x(), yy, 0.0),
-                    osg::Vec3d( grid.halfSpan.x(), yy, 0.0),
-                    grid.color
-                });
-        }
+        const osg::Vec4ub color( toBytes(grid.color) );
+        eachLine(grid, [&](const osg::Vec3f& begin, const osg::Vec3f& finish)
+                 {
+                     ends[end] = begin;
+                     colors[end++] = color;
+                     ends[end] = finish;
+                     colors[end++] = color;
+                 });
     }
 
-    return get(lines);
+    return getLines(std::move(ends), std::move(colors));
 };
 
 } // namespace d3
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Vec2>
 #include <osg/Vec4>
 #include <osg/Node>
@@ -39,7 +41,7 @@ typedef std::vector<Grid> GridVec_t;
 
 /// @brief   get an osg node from a vector of grids
 /// @param   grids The grids we should draw
-osg::ref_ptr<osg::Node> get(const GridVec_t& grids);
+D3_DECL(osg::ref_ptr<osg::Node> get(const GridVec_t& grids))
 
 /// @brief   get an osg node from a single grid
 /// @param   grid The grid that we should draw
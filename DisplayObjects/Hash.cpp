@@ -0,0 +1,110 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Hash.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     A fast hash of the data handed to the display objects
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "Hash.h"
+
+#include <cstring>
+
+namespace d3
+{
+
+namespace
+{
+
+/// The mixing primes
+static const uint64_t prime1(0x9E3779B185EBCA87ull);
+static const uint64_t prime2(0xC2B2AE3D27D4EB4Full);
+static const uint64_t prime3(0x165667B19E3779F9ull);
+static const uint64_t prime4(0x85EBCA77C2B2AE63ull);
+static const uint64_t prime5(0x27D4EB2F165667C5ull);
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Rotate left
+/////////////////////////////////////////////////////////////////
+inline uint64_t rotl(const uint64_t& value,
+                     const int& bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Read a word (any alignment)
+/////////////////////////////////////////////////////////////////
+inline uint64_t read64(const unsigned char* bytes)
+{
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Mix a word into a lane
+/////////////////////////////////////////////////////////////////
+inline uint64_t round(const uint64_t& lane,
+                      const uint64_t& word)
+{
+    return rotl(lane + word*prime2, 31) * prime1;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Fold a lane into the hash
+/////////////////////////////////////////////////////////////////
+inline uint64_t merge(const uint64_t& hash,
+                      const uint64_t& lane)
+{
+    return (hash ^ round(0, lane))*prime1 + prime4;
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+uint64_t hash(const void* data,
+              const size_t& bytes,
+              const uint64_t& seed /* = 0 */)
+{
+    const unsigned char* bb( static_cast<const unsigned char*>(data) );
+    const unsigned char* const end( bb + bytes );
+
+    uint64_t hh;
+    if ( bytes >= 32 )
+    {
+        // four independent lanes, a word each per stripe
+        uint64_t lanes[4] = { seed + prime1 + prime2, seed + prime2, seed, seed - prime1 };
+        for ( ; bb+32<=end ; bb+=32 )
+            for ( int ll(0) ; ll<4 ; ++ll )
+                lanes[ll] = round(lanes[ll], read64(bb + 8*ll));
+
+        hh = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+        for ( int ll(0) ; ll<4 ; ++ll )
+            hh = merge(hh, lanes[ll]);
+    }
+    else
+    {
+        hh = seed + prime5;
+    }
+    hh += bytes;
+
+    // the tail
+    for ( ; bb+8<=end ; bb+=8 )
+        hh = rotl(hh ^ round(0, read64(bb)), 27)*prime1 + prime4;
+    for ( ; bb<end ; ++bb )
+        hh = rotl(hh ^ (*bb*prime5), 11)*prime1;
+
+    // avalanche
+    hh ^= hh >> 33;
+    hh *= prime2;
+    hh ^= hh >> 29;
+    hh *= prime3;
+    hh ^= hh >> 32;
+    return hh;
+};
+
+} // namespace d3
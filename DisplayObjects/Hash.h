@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Hash.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     A fast hash of the data handed to the display objects
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Disable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace d3
+{
+
+/// @brief   Hash some bytes
+/// @param   data The bytes
+/// @param   bytes The number of bytes
+/// @param   seed Chain hashes by passing the previous one
+/// @return  The 64 bit hash
+///
+/// The bytes are consumed 32 at a time by four independent lanes (the layout
+/// of xxHash64), so there is no dependency from one word to the next and a
+/// large point cloud hashes at close to memory speed.
+D3_STUB(0, uint64_t hash(const void* data,
+                         const size_t& bytes,
+                         const uint64_t& seed = 0))
+
+namespace detail
+{
+/// @brief   Can a T be hashed as its bytes
+///
+/// std::is_trivially_copyable where the library has it - GCC's only does from
+/// GCC 5, so before that the compiler's own checks stand in.
+template<typename T>
+struct isPlain
+{
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ < 5)
+    static const bool value = __has_trivial_copy(T) && __has_trivial_destructor(T);
+#else
+    static const bool value = std::is_trivially_copyable<T>::value;
+#endif
+};
+} // namespace detail
+
+/// @brief   Hash a plain value (a Grid, a Point, a size, ...)
+/// @param   value The value
+/// @param   seed Chain hashes by passing the previous one
+///
+/// The value is hashed as its bytes - two equal values with different padding
+/// bytes can hash differently, which only costs a missed match.
+template<typename T>
+inline typename std::enable_if<detail::isPlain<T>::value, uint64_t>::type
+hash(const T& value,
+     const uint64_t& seed = 0)
+{
+    return hash(&value, sizeof(value), seed);
+};
+
+/// @brief   Hash a vector of plain values (a PointVec_t, LineVec_t, ...)
+/// @param   values The values
+/// @param   seed Chain hashes by passing the previous one
+template<typename T>
+inline typename std::enable_if<detail::isPlain<T>::value, uint64_t>::type
+hash(const std::vector<T>& values,
+     const uint64_t& seed = 0)
+{
+    // the count goes in too so an empty vector differs from no vector at all
+    const uint64_t count( values.size() );
+    return hash(values.data(), values.size()*sizeof(T), hash(&count, sizeof(count), seed));
+};
+
+} // namespace d3
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include "Points.h"
 
 #include <osg/Node>
@@ -53,7 +55,7 @@ struct HeightGrid
 /// @brief   get an osg node that is a height field built from a set of points
 ///          on a regularly spaced grid
 /// @param   heightGrid The height field created that we should draw
-osg::ref_ptr<osg::Node> get(const HeightGrid& heightGrid);
+D3_DECL(osg::ref_ptr<osg::Node> get(const HeightGrid& heightGrid))
 
 } // namespace d3
 
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/MatrixTransform>
 #include <osg/Image>
 
@@ -33,7 +35,7 @@ struct Image
 typedef std::vector<Image> ImageVec_t;
 
 /// The get for the vector
-osg::ref_ptr<osg::Node> get(const ImageVec_t& images);
+D3_DECL(osg::ref_ptr<osg::Node> get(const ImageVec_t& images))
 
 /// The get for a single image
 inline osg::ref_ptr<osg::Node> get(const Image& image)
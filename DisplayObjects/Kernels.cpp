@@ -0,0 +1,363 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Kernels.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     The vectorized, threaded loops the builders fill arrays with
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "Kernels.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+// the x86 kernels carry their own target, so they build whatever the
+// compile flags are and are only picked when the cpu has the instructions
+#if      defined(__x86_64__) || defined(__i386__)
+#define  D3_X86_KERNELS
+#include <immintrin.h>
+#endif   // defined(__x86_64__) || defined(__i386__)
+
+namespace d3
+{
+
+namespace
+{
+
+/// Below this many elements a loop isn't worth splitting across threads
+static const size_t parallelCount(1u << 17);
+
+/// The most threads a loop is split across
+static const unsigned int maxThreads(8);
+
+/// A bound as two corners
+struct Corners
+{
+    float lo[3];
+    float hi[3];
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   An empty bound
+/////////////////////////////////////////////////////////////////
+Corners emptyCorners()
+{
+    const float big( std::numeric_limits<float>::max() );
+    return Corners{{big, big, big}, {-big, -big, -big}};
+};
+
+/// A loop over a range of elements
+typedef void (*Narrow_t)(const unsigned char*, size_t, size_t, unsigned char*, size_t, Corners&);
+typedef void (*Pack_t)(const unsigned char*, size_t, size_t, unsigned char*, size_t);
+typedef void (*Bound_t)(const unsigned char*, size_t, size_t, Corners&);
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void narrowScalar(const unsigned char* in, size_t inStride, size_t count,
+                  unsigned char* out, size_t outStride, Corners& corners)
+{
+    for ( size_t ii(0) ; ii<count ; ++ii, in+=inStride, out+=outStride )
+    {
+        double xyz[3];
+        std::memcpy(xyz, in, sizeof(xyz));
+        const float narrow[3] = { static_cast<float>(xyz[0]), static_cast<float>(xyz[1]), static_cast<float>(xyz[2]) };
+        std::memcpy(out, narrow, sizeof(narrow));
+        for ( int kk(0) ; kk<3 ; ++kk )
+        {
+            corners.lo[kk] = std::min(corners.lo[kk], narrow[kk]);
+            corners.hi[kk] = std::max(corners.hi[kk], narrow[kk]);
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void packScalar(const unsigned char* in, size_t inStride, size_t count,
+                unsigned char* out, size_t outStride)
+{
+    for ( size_t ii(0) ; ii<count ; ++ii, in+=inStride, out+=outStride )
+    {
+        float rgba[4];
+        std::memcpy(rgba, in, sizeof(rgba));
+        for ( int kk(0) ; kk<4 ; ++kk )
+            out[kk] = static_cast<unsigned char>(std::min(1.0f, std::max(0.0f, rgba[kk]))*255.0f + 0.5f);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void boundScalar(const unsigned char* in, size_t stride, size_t count, Corners& corners)
+{
+    for ( size_t ii(0) ; ii<count ; ++ii, in+=stride )
+    {
+        float xyz[3];
+        std::memcpy(xyz, in, sizeof(xyz));
+        for ( int kk(0) ; kk<3 ; ++kk )
+        {
+            corners.lo[kk] = std::min(corners.lo[kk], xyz[kk]);
+            corners.hi[kk] = std::max(corners.hi[kk], xyz[kk]);
+        }
+    }
+};
+
+#ifdef   D3_X86_KERNELS
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Fold the x, y and z lanes of two registers into corners
+/////////////////////////////////////////////////////////////////
+__attribute__((target("sse2")))
+void storeCorners(const __m128& lo, const __m128& hi, Corners& corners)
+{
+    float los[4], his[4];
+    _mm_storeu_ps(los, lo);
+    _mm_storeu_ps(his, hi);
+    for ( int kk(0) ; kk<3 ; ++kk )
+    {
+        corners.lo[kk] = std::min(corners.lo[kk], los[kk]);
+        corners.hi[kk] = std::max(corners.hi[kk], his[kk]);
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Store x, y and z - exactly 12 bytes, never past the location
+/////////////////////////////////////////////////////////////////
+__attribute__((target("sse2")))
+inline void storeXyz(unsigned char* out, const __m128& xyz)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(out), xyz);
+    _mm_store_ss(reinterpret_cast<float*>(out) + 2, _mm_movehl_ps(xyz, xyz));
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+__attribute__((target("sse2")))
+void narrowSse(const unsigned char* in, size_t inStride, size_t count,
+               unsigned char* out, size_t outStride, Corners& corners)
+{
+    __m128 lo( _mm_set1_ps(std::numeric_limits<float>::max()) );
+    __m128 hi( _mm_set1_ps(-std::numeric_limits<float>::max()) );
+    for ( size_t ii(0) ; ii<count ; ++ii, in+=inStride, out+=outStride )
+    {
+        const double* xyz( reinterpret_cast<const double*>(in) );
+        const __m128 xy( _mm_cvtpd_ps(_mm_loadu_pd(xyz)) );
+        const __m128 z( _mm_cvtpd_ps(_mm_load_sd(xyz + 2)) );
+        const __m128 narrow( _mm_movelh_ps(xy, z) );
+        storeXyz(out, narrow);
+        // a NaN in the first operand gives the second, so a NaN point
+        // keeps the bound the way std::min and std::max do
+        lo = _mm_min_ps(narrow, lo);
+        hi = _mm_max_ps(narrow, hi);
+    }
+    storeCorners(lo, hi, corners);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+__attribute__((target("avx")))
+void narrowAvx(const unsigned char* in, size_t inStride, size_t count,
+               unsigned char* out, size_t outStride, Corners& corners)
+{
+    // the masked lane is never read, so the last location can't fault
+    const __m256i xyzMask( _mm256_setr_epi64x(-1, -1, -1, 0) );
+    __m128 lo( _mm_set1_ps(std::numeric_limits<float>::max()) );
+    __m128 hi( _mm_set1_ps(-std::numeric_limits<float>::max()) );
+    for ( size_t ii(0) ; ii<count ; ++ii, in+=inStride, out+=outStride )
+    {
+        const __m128 narrow( _mm256_cvtpd_ps(_mm256_maskload_pd(reinterpret_cast<const double*>(in), xyzMask)) );
+        storeXyz(out, narrow);
+        lo = _mm_min_ps(narrow, lo);
+        hi = _mm_max_ps(narrow, hi);
+    }
+    storeCorners(lo, hi, corners);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+__attribute__((target("sse2")))
+void packSse(const unsigned char* in, size_t inStride, size_t count,
+             unsigned char* out, size_t outStride)
+{
+    const __m128 zero( _mm_setzero_ps() );
+    const __m128 one( _mm_set1_ps(1.0f) );
+    const __m128 scale( _mm_set1_ps(255.0f) );
+    const __m128 half( _mm_set1_ps(0.5f) );
+    for ( size_t ii(0) ; ii<count ; ++ii, in+=inStride, out+=outStride )
+    {
+        // clamped the way toBytes() does it, a NaN ends up 0
+        __m128 rgba( _mm_loadu_ps(reinterpret_cast<const float*>(in)) );
+        rgba = _mm_min_ps(_mm_max_ps(rgba, zero), one);
+        __m128i bytes( _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(rgba, scale), half)) );
+        bytes = _mm_packs_epi32(bytes, bytes);
+        bytes = _mm_packus_epi16(bytes, bytes);
+        const int32_t packed( _mm_cvtsi128_si32(bytes) );
+        std::memcpy(out, &packed, sizeof(packed));
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+__attribute__((target("sse2")))
+void boundSse(const unsigned char* in, size_t stride, size_t count, Corners& corners)
+{
+    __m128 lo( _mm_set1_ps(std::numeric_limits<float>::max()) );
+    __m128 hi( _mm_set1_ps(-std::numeric_limits<float>::max()) );
+    for ( size_t ii(0) ; ii<count ; ++ii, in+=stride )
+    {
+        const float* xyz( reinterpret_cast<const float*>(in) );
+        const __m128 xy( _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(xyz))) );
+        const __m128 point( _mm_movelh_ps(xy, _mm_load_ss(xyz + 2)) );
+        lo = _mm_min_ps(point, lo);
+        hi = _mm_max_ps(point, hi);
+    }
+    storeCorners(lo, hi, corners);
+};
+
+#endif   // D3_X86_KERNELS
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The fastest conversion this cpu has
+/////////////////////////////////////////////////////////////////
+Narrow_t narrowKernel()
+{
+#ifdef   D3_X86_KERNELS
+    if ( __builtin_cpu_supports("avx") ) return &narrowAvx;
+    if ( __builtin_cpu_supports("sse2") ) return &narrowSse;
+#endif   // D3_X86_KERNELS
+    return &narrowScalar;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The fastest color packing this cpu has
+/////////////////////////////////////////////////////////////////
+Pack_t packKernel()
+{
+#ifdef   D3_X86_KERNELS
+    if ( __builtin_cpu_supports("sse2") ) return &packSse;
+#endif   // D3_X86_KERNELS
+    return &packScalar;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The fastest bound this cpu has
+/////////////////////////////////////////////////////////////////
+Bound_t boundKernel()
+{
+#ifdef   D3_X86_KERNELS
+    if ( __builtin_cpu_supports("sse2") ) return &boundSse;
+#endif   // D3_X86_KERNELS
+    return &boundScalar;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The threads to split a loop over some elements across
+/////////////////////////////////////////////////////////////////
+unsigned int threadsFor(const size_t& count)
+{
+    const unsigned int cores( std::max(1u, std::thread::hardware_concurrency()) );
+    return static_cast<unsigned int>(std::min<size_t>(std::min(cores, maxThreads),
+                                                      std::max<size_t>(1, count/parallelCount)));
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Run a loop over [0,count) in slices, one per thread
+/// @param   count The number of elements
+/// @param   loop Called as loop(begin, end, slice)
+/// @return  The number of slices
+/////////////////////////////////////////////////////////////////
+template<typename Loop>
+unsigned int split(const size_t& count,
+                   const Loop& loop)
+{
+    const unsigned int slices( threadsFor(count) );
+    if ( 1 == slices )
+    {
+        loop(0, count, 0);
+        return slices;
+    }
+
+    const size_t perSlice( (count + slices - 1)/slices );
+    std::vector<std::thread> workers;
+    workers.reserve(slices - 1);
+    for ( unsigned int slice(1) ; slice<slices ; ++slice )
+        workers.emplace_back(loop, std::min(count, slice*perSlice), std::min(count, (slice + 1)*perSlice), slice);
+    loop(0, std::min(count, perSlice), 0);
+    for ( std::thread& worker : workers ) worker.join();
+    return slices;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Expand a bound by some corners
+/////////////////////////////////////////////////////////////////
+void expand(osg::BoundingBox& bound,
+            const Corners& corners)
+{
+    if ( corners.lo[0] > corners.hi[0] ) return;
+    bound.expandBy(osg::BoundingBox(corners.lo[0], corners.lo[1], corners.lo[2],
+                                    corners.hi[0], corners.hi[1], corners.hi[2]));
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void narrowToFloats(const double* xyz,
+                    const size_t& inStride,
+                    const size_t& count,
+                    float* out,
+                    const size_t& outStride,
+                    osg::BoundingBox& bound)
+{
+    const unsigned char* in( reinterpret_cast<const unsigned char*>(xyz) );
+    unsigned char* to( reinterpret_cast<unsigned char*>(out) );
+    const Narrow_t kernel( narrowKernel() );
+
+    std::vector<Corners> corners(threadsFor(count), emptyCorners());
+    split(count, [&](const size_t& begin, const size_t& end, const unsigned int& slice)
+          {
+              kernel(in + begin*inStride, inStride, end - begin, to + begin*outStride, outStride, corners[slice]);
+          });
+    for ( const Corners& slice : corners ) expand(bound, slice);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void packColors(const float* rgba,
+                const size_t& inStride,
+                const size_t& count,
+                unsigned char* out,
+                const size_t& outStride)
+{
+    const unsigned char* in( reinterpret_cast<const unsigned char*>(rgba) );
+    const Pack_t kernel( packKernel() );
+
+    split(count, [&](const size_t& begin, const size_t& end, const unsigned int&)
+          {
+              kernel(in + begin*inStride, inStride, end - begin, out + begin*outStride, outStride);
+          });
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+void growBound(const float* xyz,
+               const size_t& stride,
+               const size_t& count,
+               osg::BoundingBox& bound)
+{
+    const unsigned char* in( reinterpret_cast<const unsigned char*>(xyz) );
+    const Bound_t kernel( boundKernel() );
+
+    std::vector<Corners> corners(threadsFor(count), emptyCorners());
+    split(count, [&](const size_t& begin, const size_t& end, const unsigned int& slice)
+          {
+              kernel(in + begin*stride, stride, end - begin, corners[slice]);
+          });
+    for ( const Corners& slice : corners ) expand(bound, slice);
+};
+
+} // namespace d3
@@ -0,0 +1,61 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Kernels.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     The vectorized, threaded loops the builders fill arrays with
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Disable.h"
+
+#include <osg/BoundingBox>
+
+#include <cstddef>
+
+namespace d3
+{
+
+/// @brief   Narrow double locations to floats and find their bound
+/// @param   xyz The x, y and z of the first location (doubles)
+/// @param   inStride The bytes from one location to the next
+/// @param   count The number of locations
+/// @param   out Where the first float x, y and z go
+/// @param   outStride The bytes from one float location to the next
+/// @param   bound Expanded by the float locations
+///
+/// Uses AVX or SSE2 where the cpu has them, a plain loop otherwise, and splits
+/// large counts across threads.
+D3_STUB(void(), void narrowToFloats(const double* xyz,
+                                    const size_t& inStride,
+                                    const size_t& count,
+                                    float* out,
+                                    const size_t& outStride,
+                                    osg::BoundingBox& bound))
+
+/// @brief   Pack float colors into normalized bytes (same as toBytes())
+/// @param   rgba The red, green, blue and alpha of the first color (floats)
+/// @param   inStride The bytes from one color to the next
+/// @param   count The number of colors
+/// @param   out Where the first four bytes go
+/// @param   outStride The bytes from one packed color to the next
+D3_STUB(void(), void packColors(const float* rgba,
+                                const size_t& inStride,
+                                const size_t& count,
+                                unsigned char* out,
+                                const size_t& outStride))
+
+/// @brief   Find the bound of float locations
+/// @param   xyz The x, y and z of the first location (floats)
+/// @param   stride The bytes from one location to the next
+/// @param   count The number of locations
+/// @param   bound Expanded by the locations
+D3_STUB(void(), void growBound(const float* xyz,
+                               const size_t& stride,
+                               const size_t& count,
+                               osg::BoundingBox& bound))
+
+} // namespace d3
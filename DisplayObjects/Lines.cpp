@@ -8,57 +8,36 @@
 /// @attention All rights reserved
 /////////////////////////////////////////////////////////////////
 
+#include "Compact.h"
+#include "Kernels.h"
 #include "Lines.h"
 
+#include <osg/Geode>
 #include <osg/Geometry>
-#include <osg/Version>
 
 namespace d3
 {
 
+namespace
+{
+
 /////////////////////////////////////////////////////////////////
+/// @brief   Make the node of some line segments from their arrays
+/// @param   verts The ends, each pair a segment
+/// @param   osgColors The color of each end (or a single color)
+/// @param   bound The bound of the ends
 /////////////////////////////////////////////////////////////////
-osg::ref_ptr<osg::Node> get(const LineVec_t& lines)
+osg::ref_ptr<osg::Node> segments(const osg::ref_ptr<osg::Vec3Array>& verts,
+                                 const osg::ref_ptr<osg::Vec4ubArray>& osgColors,
+                                 const osg::BoundingBox& bound)
 {
-    // define the color array - these are all the colors we need!
-    osg::ref_ptr<osg::Vec4Array> osgColors( new osg::Vec4Array() );
-
-    // here are the lines lto add
-    osg::ref_ptr<osg::Vec3Array> verts( new osg::Vec3Array() );
-
-    // color mapping
-    osg::ref_ptr<osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType, 4, 4> >
-        colorIndexArray(new osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType, 4, 4>());
-
-    // the actual line indices
-    osg::ref_ptr<osg::DrawElementsUInt> theLines( new osg::DrawElementsUInt(osg::PrimitiveSet::LINES, 0) );
-
-    // add the lines and colors - only iterate the list once so we know we have
-    // the right number of lines and colors
-    unsigned int index(0);
-    for ( const Line& line : lines )
-    {
-        verts->push_back(line.begin);
-        osgColors->push_back(line.color);
-        colorIndexArray->push_back(index);
-        theLines->push_back(index++);
-
-        verts->push_back(line.end);
-        osgColors->push_back(line.color);
-        colorIndexArray->push_back(index);
-        theLines->push_back(index++);
-    }
-
-    // now add all this stuff to the geometry object
+    // now add all this stuff to the geometry object - each pair of vertices is
+    // a line, so there are no indices
     osg::ref_ptr<osg::Geometry> cloudGeometry( new osg::Geometry() );
     cloudGeometry->setVertexArray(verts);
-#if      OSG_MIN_VERSION_REQUIRED(3,2,0)
-    cloudGeometry->setColorArray(osgColors, osg::Array::Binding::BIND_PER_VERTEX);
-#else    // OSG_MIN_VERSION_REQUIRED(3,2,0)
-    cloudGeometry->setColorArray(osgColors);
-    cloudGeometry->setColorBinding(osg::Geometry::BIND_PER_VERTEX);
-#endif   // OSG_MIN_VERSION_REQUIRED(3,2,0)
-    cloudGeometry->addPrimitiveSet(theLines);
+    if ( bound.valid() ) setKnownBound(cloudGeometry, bound);
+    setCompactColors(cloudGeometry, osgColors);
+    cloudGeometry->addPrimitiveSet(drawInOrder(osg::PrimitiveSet::LINES, verts->size()));
 
     // set the state - line size and lighting
     cloudGeometry->getOrCreateStateSet()->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
@@ -69,4 +48,51 @@ osg::ref_ptr<osg::Node> get(const LineVec_t& lines)
     return geode;
 };
 
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> get(const LineVec_t& lines)
+{
+    // the ends and colors go straight into the arrays handed to GL, narrowed
+    // and packed a few at a time and bounded on the way - the beginnings fill
+    // the even slots and the ends the odd ones
+    osg::ref_ptr<osg::Vec3Array> verts( new osg::Vec3Array(2*lines.size()) );
+    osg::ref_ptr<osg::Vec4ubArray> osgColors( new osg::Vec4ubArray(2*lines.size()) );
+    osg::BoundingBox bound;
+    if ( not lines.empty() )
+    {
+        narrowToFloats(lines.front().begin.ptr(), sizeof(Line), lines.size(),
+                       (*verts)[0].ptr(), 2*sizeof(osg::Vec3f), bound);
+        narrowToFloats(lines.front().end.ptr(), sizeof(Line), lines.size(),
+                       (*verts)[1].ptr(), 2*sizeof(osg::Vec3f), bound);
+        packColors(lines.front().color.ptr(), sizeof(Line), lines.size(),
+                   (*osgColors)[0].ptr(), 2*sizeof(osg::Vec4ub));
+        packColors(lines.front().color.ptr(), sizeof(Line), lines.size(),
+                   (*osgColors)[1].ptr(), 2*sizeof(osg::Vec4ub));
+    }
+    return segments(verts, osgColors, bound);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> getLines(std::vector<osg::Vec3f>&& ends,
+                                 std::vector<osg::Vec4ub>&& colors)
+{
+    // one color for all, or one for each end (white for any missing)
+    if ( (1 != colors.size()) && (colors.size() != ends.size()) )
+        colors.resize(ends.size(), osg::Vec4ub(255, 255, 255, 255));
+
+    // take the vectors over rather than copying them
+    osg::ref_ptr<osg::Vec3Array> verts( new osg::Vec3Array() );
+    verts->asVector().swap(ends);
+    osg::ref_ptr<osg::Vec4ubArray> osgColors( new osg::Vec4ubArray() );
+    osgColors->asVector().swap(colors);
+
+    osg::BoundingBox bound;
+    if ( not verts->empty() )
+        growBound(verts->front().ptr(), sizeof(osg::Vec3f), verts->size(), bound);
+    return segments(verts, osgColors, bound);
+};
+
 } // namespace d3
@@ -10,9 +10,12 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Geode>
 #include <osg/Vec3>
 #include <osg/Vec4>
+#include <osg/Vec4ub>
 
 #include <vector>
 
@@ -38,14 +41,27 @@ typedef std::vector<Line> LineVec_t;
 /// @brief   get an osg node from a vector of lines
 /// @param   lines The lines we should draw
 /// @return  The built node
-osg::ref_ptr<osg::Node> get(const LineVec_t& lines);
+D3_DECL(osg::ref_ptr<osg::Node> get(const LineVec_t& lines))
+
+/// @brief   get an osg node that takes over the arrays of some lines
+/// @param   ends The two ends of each line, one after the other - moved into
+///          the vertex array, not copied
+/// @param   colors The color of each end, or a single color for all of them
+///          - moved into the color array, not copied
+/// @return  The built node
+D3_DECL(osg::ref_ptr<osg::Node> getLines(std::vector<osg::Vec3f>&& ends,
+                                         std::vector<osg::Vec4ub>&& colors))
 
 /// @brief   get an osg node from a single line
 /// @param   line the line that we should draw
 /// @return  The built node
 inline osg::ref_ptr<osg::Node> get(const Line& line)
 {
+#ifdef   D3_DISABLE
+    return nullptr;
+#else    // D3_DISABLE
     return get(LineVec_t(1, line));
+#endif   // D3_DISABLE
 };
 
 } // namespace d3
@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Memory.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Account for the memory held by a displayed node
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include "Memory.h"
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/NodeVisitor>
+#include <osg/Texture>
+
+#include <unordered_set>
+
+namespace d3
+{
+
+namespace
+{
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Visitor summing the buffer data under a node
+/////////////////////////////////////////////////////////////////
+class ByteSizeVisitor : public osg::NodeVisitor
+{
+  public:
+
+    /// @brief   Constructor
+    ByteSizeVisitor() :
+        osg::NodeVisitor(osg::NodeVisitor::TRAVERSE_ALL_CHILDREN),
+        m_bytes(0),
+        m_seen()
+    {
+        // count the hidden stuff too
+        setNodeMaskOverride(~0);
+    };
+
+    /// @brief   The total so far
+    size_t getBytes() const { return m_bytes; };
+
+    /// @brief   Any node - look at its state
+    virtual void apply(osg::Node& node)
+    {
+        add(node.getStateSet());
+        traverse(node);
+    };
+
+    /// @brief   The geometry lives in the geodes
+    virtual void apply(osg::Geode& geode)
+    {
+        add(geode.getStateSet());
+        for ( unsigned int ii(0) ; ii<geode.getNumDrawables() ; ++ii )
+        {
+            const osg::Drawable* drawable( geode.getDrawable(ii) );
+            add(drawable->getStateSet());
+
+            const osg::Geometry* geometry( drawable->asGeometry() );
+            if ( nullptr == geometry ) continue;
+
+            add(geometry->getVertexArray());
+            add(geometry->getNormalArray());
+            add(geometry->getColorArray());
+            for ( unsigned int jj(0) ; jj<geometry->getNumTexCoordArrays() ; ++jj )
+                add(geometry->getTexCoordArray(jj));
+            for ( unsigned int jj(0) ; jj<geometry->getNumPrimitiveSets() ; ++jj )
+            {
+                const osg::PrimitiveSet* primitives( geometry->getPrimitiveSet(jj) );
+                if ( firstTime(primitives) ) m_bytes += primitives->getTotalDataSize();
+            }
+        }
+    };
+
+  private:
+
+    /// @brief   Have we not counted this one before
+    bool firstTime(const osg::Referenced* ref)
+    {
+        return (nullptr != ref) && m_seen.insert(ref).second;
+    };
+
+    /// @brief   Count an array
+    void add(const osg::Array* array)
+    {
+        if ( firstTime(array) ) m_bytes += array->getTotalDataSize();
+    };
+
+    /// @brief   Count the images of the textures in a state set
+    void add(const osg::StateSet* stateSet)
+    {
+        if ( not firstTime(stateSet) ) return;
+        for ( unsigned int unit(0) ; unit<stateSet->getTextureAttributeList().size() ; ++unit )
+        {
+            const osg::Texture* texture( dynamic_cast<const osg::Texture*>
+                                         (stateSet->getTextureAttribute(unit, osg::StateAttribute::TEXTURE)) );
+            if ( nullptr == texture ) continue;
+            for ( unsigned int ii(0) ; ii<texture->getNumImages() ; ++ii )
+            {
+                const osg::Image* image( texture->getImage(ii) );
+                if ( firstTime(image) ) m_bytes += image->getTotalSizeInBytes();
+            }
+        }
+    };
+
+    /// The running total
+    size_t                                  m_bytes;
+
+    /// What has been counted already
+    std::unordered_set<const osg::Referenced*> m_seen;
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+size_t getByteSize(const osg::Node* node)
+{
+    if ( nullptr == node ) return 0;
+
+    ByteSizeVisitor visitor;
+    const_cast<osg::Node*>(node)->accept(visitor);
+    return visitor.getBytes();
+};
+
+} // namespace d3
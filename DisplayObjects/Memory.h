@@ -0,0 +1,32 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Memory.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Account for the memory held by a displayed node
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Disable.h"
+
+#include <osg/Node>
+
+#include <cstddef>
+
+namespace d3
+{
+
+/// @brief   The bytes of vertex data, indices and images held by a subtree
+/// @param   node The root of the subtree
+/// @return  size_t The number of bytes (each shared array or image is counted
+///          once)
+///
+/// This is the data that gets uploaded to the graphics card, not the size of
+/// the osg objects themselves, which is a good measure of what a display
+/// object costs.
+D3_STUB(0, size_t getByteSize(const osg::Node* node))
+
+} // namespace d3
@@ -8,12 +8,13 @@
 /// @attention All rights reserved
 /////////////////////////////////////////////////////////////////
 
+#include "Compact.h"
+#include "Kernels.h"
 #include "MeshGrid.h"
 
 #include <osg/Geometry>
 #include <osg/Geode>
 #include <osg/PolygonMode>
-#include <osg/Version>
 
 namespace d3
 {
@@ -22,36 +23,30 @@ namespace d3
 /////////////////////////////////////////////////////////////////
 osg::ref_ptr<osg::Node> get(const MeshGrid& meshGrid)
 {
-    // build the vertex array
-    osg::ref_ptr<osg::Vec3Array> vertices( new osg::Vec3Array() );
-    vertices->reserve(meshGrid.points.size());
-
-    // Construct the color array
-    osg::ref_ptr<osg::Vec4Array> colors( new osg::Vec4Array() );
-    colors->reserve(meshGrid.points.size());
-
-    // add the points to the vetext and color array
-    for ( const auto& pt : meshGrid.points )
+    // build the vertex and color arrays (the colors compacted once they are
+    // all in) - narrowed and packed a few at a time and bounded on the way
+    osg::ref_ptr<osg::Vec3Array> vertices( new osg::Vec3Array(meshGrid.points.size()) );
+    osg::ref_ptr<osg::Vec4ubArray> colors( new osg::Vec4ubArray(meshGrid.points.size()) );
+    osg::BoundingBox bound;
+    if ( not meshGrid.points.empty() )
     {
-        vertices->push_back( pt.location );
-        colors->push_back( pt.color );
+        narrowToFloats(meshGrid.points.front().location.ptr(), sizeof(Point), meshGrid.points.size(),
+                       vertices->front().ptr(), sizeof(osg::Vec3f), bound);
+        packColors(meshGrid.points.front().color.ptr(), sizeof(Point), meshGrid.points.size(),
+                   colors->front().ptr(), sizeof(osg::Vec4ub));
     }
 
-    // The normal array
+    // The normal array - it is bound overall, so only the first one is used
     osg::ref_ptr<osg::Vec3Array> normals( new osg::Vec3Array() );
-    for ( const auto& nn : meshGrid.normals )
-        normals->push_back(nn);
+    if ( not meshGrid.normals.empty() )
+        normals->push_back(meshGrid.normals.front());
 
     // Construct the polygon geometry
     osg::ref_ptr<osg::Geometry> polygon( new osg::Geometry() );
     polygon->setVertexArray( vertices.get() );
+    if ( bound.valid() ) setKnownBound( polygon.get(), bound );
     polygon->setNormalArray( normals.get() );
-#if      OSG_MIN_VERSION_REQUIRED(3,2,0)
-    polygon->setColorArray( colors.get(), osg::Array::Binding::BIND_PER_VERTEX );
-#else    // OSG_MIN_VERSION_REQUIRED(3,2,0)
-    polygon->setColorArray(colors.get());
-    polygon->setColorBinding(osg::Geometry::BIND_PER_VERTEX);
-#endif   // OSG_MIN_VERSION_REQUIRED(3,2,0)
+    setCompactColors( polygon.get(), colors );
     polygon->setNormalBinding( osg::Geometry::BIND_OVERALL );
     if ( not meshGrid.fill )
     {
@@ -63,18 +58,19 @@ osg::ref_ptr<osg::Node> get(const MeshGrid& meshGrid)
     polygon->getOrCreateStateSet()->setMode(GL_BLEND, osg::StateAttribute::ON);
     polygon->getOrCreateStateSet()->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
 
-    // build the thing
-    for ( uint ii=0 ; ii<meshGrid.points.size()-meshGrid.width-1 ; ++ii )
+    // build the thing - all the quads in one set of indices
+    osg::ref_ptr<osg::DrawElements> quads( drawIndexed(osg::PrimitiveSet::QUADS, meshGrid.points.size()) );
+    if ( meshGrid.points.size() > meshGrid.width )
+        quads->reserveElements(4*(meshGrid.points.size() - meshGrid.width));
+    for ( uint ii=0 ; ii+meshGrid.width+1<meshGrid.points.size() ; ++ii )
     {
         if ( not ((ii+1) % meshGrid.width) ) ++ii;
-        osg::ref_ptr<osg::DrawElementsUInt>
-            pyramidBase(new osg::DrawElementsUInt(osg::PrimitiveSet::QUADS, 0));
-        pyramidBase->push_back(ii);
-        pyramidBase->push_back(ii+1);
-        pyramidBase->push_back(ii+meshGrid.width+1);
-        pyramidBase->push_back(ii+meshGrid.width);
-        polygon->addPrimitiveSet(pyramidBase);
+        quads->addElement(ii);
+        quads->addElement(ii+1);
+        quads->addElement(ii+meshGrid.width+1);
+        quads->addElement(ii+meshGrid.width);
     }
+    polygon->addPrimitiveSet(quads);
 
     // create a geode for this
     osg::ref_ptr<osg::Geode> geode( new osg::Geode() );
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include "Points.h"
 
 #include <osg/Node>
@@ -48,7 +50,7 @@ struct MeshGrid
 /// @brief   get an osg node that is a mesh built from a set of points on a
 ///          regularly spaced grid
 /// @param   meshGrid The mesh grid created that we should draw
-osg::ref_ptr<osg::Node> get(const MeshGrid& meshGrid);
+D3_DECL(osg::ref_ptr<osg::Node> get(const MeshGrid& meshGrid))
 
 } // namespace d3
 
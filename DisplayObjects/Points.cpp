@@ -9,54 +9,48 @@
 /////////////////////////////////////////////////////////////////
 
 #include "Colors.h"
+#include "Compact.h"
+#include "Kernels.h"
 #include "Points.h"
 
 #include <osg/Geometry>
 #include <osg/Point>
 #include <osg/Geode>
-#include <osg/Version>
+
+#include <cstring>
 
 namespace d3
 {
 
+namespace
+{
+
 /////////////////////////////////////////////////////////////////
+/// @brief   Make the node of a cloud from its arrays
+/// @param   verts The vertices
+/// @param   osgColors The color of each vertex (or a single color)
+/// @param   size The size of all the points
+/// @param   bound The bound of the vertices (found here if null)
 /////////////////////////////////////////////////////////////////
-osg::ref_ptr<osg::Node> get(const PointVec_t& points,
-                            const float size)
+osg::ref_ptr<osg::Node> cloud(const osg::ref_ptr<osg::Vec3Array>& verts,
+                              const osg::ref_ptr<osg::Vec4ubArray>& osgColors,
+                              const float size,
+                              const osg::BoundingBox* bound = nullptr)
 {
-    // the color array
-    osg::ref_ptr<osg::Vec4Array> osgColors( new osg::Vec4Array() );
-    osgColors->reserve(points.size());
-
-    // the vertex array
-    osg::ref_ptr<osg::Vec3Array> verts( new osg::Vec3Array() );
-    verts->reserve(points.size());
-
-    // the actual cloud indices
-    osg::ref_ptr<osg::DrawElementsUInt>
-        theCloud( new osg::DrawElementsUInt(osg::PrimitiveSet::POINTS, 0) );
-    theCloud->reserveElements(points.size());
-
-    // add the points and colors - only iterate the list once so we know we have
-    // the right number of points and colors
-    unsigned int index(0);
-    for ( const Point& pt : points )
+    osg::BoundingBox found;
+    if ( (nullptr == bound) && not verts->empty() )
     {
-        verts->push_back(pt.location);
-        osgColors->push_back(pt.color);
-        theCloud->push_back(index++);
+        growBound(verts->front().ptr(), sizeof(osg::Vec3f), verts->size(), found);
+        bound = &found;
     }
 
-    // now add all this stuff to the geometry object
+    // now add all this stuff to the geometry object - the points are drawn in
+    // order, so there are no indices
     osg::ref_ptr<osg::Geometry> cloudGeometry( new osg::Geometry() );
     cloudGeometry->setVertexArray(verts);
-#if      OSG_MIN_VERSION_REQUIRED(3,2,0)
-    cloudGeometry->setColorArray(osgColors, osg::Array::Binding::BIND_PER_VERTEX);
-#else    // OSG_MIN_VERSION_REQUIRED(3,2,0)
-    cloudGeometry->setColorArray(osgColors);
-    cloudGeometry->setColorBinding(osg::Geometry::BIND_PER_VERTEX);
-#endif   // OSG_MIN_VERSION_REQUIRED(3,2,0)
-    cloudGeometry->addPrimitiveSet(theCloud);
+    if ( nullptr != bound ) setKnownBound(cloudGeometry, *bound);
+    setCompactColors(cloudGeometry, osgColors);
+    cloudGeometry->addPrimitiveSet(drawInOrder(osg::PrimitiveSet::POINTS, verts->size()));
 
     // set the state - point size and lighting
     osg::ref_ptr<osg::StateSet> cloudStateSet( cloudGeometry->getOrCreateStateSet() );
@@ -69,4 +63,109 @@ osg::ref_ptr<osg::Node> get(const PointVec_t& points,
     return geode;
 };
 
+/////////////////////////////////////////////////////////////////
+/// @brief   Copy raw point locations into a vertex array
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Vec3Array> vertices(const float* xyz,
+                                      const size_t& xyzStride,
+                                      const size_t& numPoints)
+{
+    osg::ref_ptr<osg::Vec3Array> verts( new osg::Vec3Array(numPoints) );
+    const unsigned char* source( reinterpret_cast<const unsigned char*>(xyz) );
+
+    // packed floats are the layout of the array already
+    if ( sizeof(osg::Vec3f) == xyzStride )
+    {
+        std::memcpy(&verts->front(), source, numPoints*sizeof(osg::Vec3f));
+        return verts;
+    }
+
+    for ( size_t ii(0) ; ii<numPoints ; ++ii, source+=xyzStride )
+        std::memcpy(&(*verts)[ii], source, sizeof(osg::Vec3f));
+    return verts;
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> get(const PointVec_t& points,
+                            const float size)
+{
+    if ( points.empty() ) return cloud(new osg::Vec3Array(), new osg::Vec4ubArray(), size);
+
+    // the locations and colors go straight into the arrays handed to GL,
+    // narrowed and packed a few at a time and bounded on the way
+    osg::ref_ptr<osg::Vec3Array> verts( new osg::Vec3Array(points.size()) );
+    osg::ref_ptr<osg::Vec4ubArray> osgColors( new osg::Vec4ubArray(points.size()) );
+    osg::BoundingBox bound;
+    narrowToFloats(points.front().location.ptr(), sizeof(Point), points.size(),
+                   verts->front().ptr(), sizeof(osg::Vec3f), bound);
+    packColors(points.front().color.ptr(), sizeof(Point), points.size(),
+               osgColors->front().ptr(), sizeof(osg::Vec4ub));
+    return cloud(verts, osgColors, size, &bound);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> get(const float* xyz,
+                            const size_t& xyzStride,
+                            const uint8_t* rgba,
+                            const size_t& rgbaStride,
+                            const size_t& numPoints,
+                            const float size)
+{
+    if ( (nullptr == xyz) || (0 == numPoints) ) return cloud(new osg::Vec3Array(), new osg::Vec4ubArray(), size);
+
+    // no colors is all white, the same as the adopting get() does for missing
+    // ones
+    if ( nullptr == rgba )
+        return cloud(vertices(xyz, xyzStride, numPoints), new osg::Vec4ubArray(1, toBytes(white())), size);
+
+    osg::ref_ptr<osg::Vec4ubArray> osgColors( new osg::Vec4ubArray(numPoints) );
+    if ( sizeof(osg::Vec4ub) == rgbaStride )
+    {
+        std::memcpy(&osgColors->front(), rgba, numPoints*sizeof(osg::Vec4ub));
+    }
+    else
+    {
+        for ( size_t ii(0) ; ii<numPoints ; ++ii )
+            std::memcpy(&(*osgColors)[ii], rgba + ii*rgbaStride, sizeof(osg::Vec4ub));
+    }
+
+    return cloud(vertices(xyz, xyzStride, numPoints), osgColors, size);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> get(const float* xyz,
+                            const size_t& xyzStride,
+                            const size_t& numPoints,
+                            const osg::Vec4& color,
+                            const float size)
+{
+    if ( (nullptr == xyz) || (0 == numPoints) ) return cloud(new osg::Vec3Array(), new osg::Vec4ubArray(), size);
+
+    return cloud(vertices(xyz, xyzStride, numPoints), new osg::Vec4ubArray(1, toBytes(color)), size);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> get(std::vector<osg::Vec3f>&& locations,
+                            std::vector<osg::Vec4ub>&& colors,
+                            const float size)
+{
+    // one color for all, or one for each (white for any missing)
+    if ( (1 != colors.size()) && (colors.size() != locations.size()) )
+        colors.resize(locations.size(), osg::Vec4ub(255, 255, 255, 255));
+
+    // take the vectors over rather than copying them
+    osg::ref_ptr<osg::Vec3Array> verts( new osg::Vec3Array() );
+    verts->asVector().swap(locations);
+    osg::ref_ptr<osg::Vec4ubArray> osgColors( new osg::Vec4ubArray() );
+    osgColors->asVector().swap(colors);
+
+    return cloud(verts, osgColors, size);
+};
+
 } // namespace d3
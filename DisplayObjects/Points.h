@@ -10,10 +10,17 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Vec3>
 #include <osg/Vec4>
+#include <osg/Vec4ub>
 #include <osg/Node>
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace d3
 {
 
@@ -33,8 +40,58 @@ typedef std::vector<Point> PointVec_t;
 /// @brief   get an osg node from a vector of points
 /// @param   points The points to add
 /// @param   size The size of all the points
-osg::ref_ptr<osg::Node> get(const PointVec_t& points,
-                            const float size = 3.0);
+D3_DECL(osg::ref_ptr<osg::Node> get(const PointVec_t& points,
+                                    const float size = 3.0))
+
+/// @brief   get an osg node straight from raw point data
+/// @param   xyz The x, y and z of the first point (floats)
+/// @param   xyzStride The bytes from one point's x to the next (12 if packed)
+/// @param   rgba The red, green, blue and alpha bytes of the first point
+///          (null draws them all white)
+/// @param   rgbaStride The bytes from one point's red to the next (4 if
+///          packed)
+/// @param   numPoints The number of points
+/// @param   size The size of all the points
+///
+/// For clouds already in memory as floats, either as separate arrays or
+/// interleaved in a struct (pass the same struct stride twice). The data is
+/// copied once, into the arrays handed to GL, with no PointVec_t in between.
+D3_DECL(osg::ref_ptr<osg::Node> get(const float* xyz,
+                                    const size_t& xyzStride,
+                                    const uint8_t* rgba,
+                                    const size_t& rgbaStride,
+                                    const size_t& numPoints,
+                                    const float size = 3.0))
+
+/// @brief   get an osg node straight from raw point data, all one color
+/// @param   xyz The x, y and z of the first point (floats)
+/// @param   xyzStride The bytes from one point's x to the next (12 if packed)
+/// @param   numPoints The number of points
+/// @param   color The color of all the points
+/// @param   size The size of all the points
+D3_DECL(osg::ref_ptr<osg::Node> get(const float* xyz,
+                                    const size_t& xyzStride,
+                                    const size_t& numPoints,
+                                    const osg::Vec4& color,
+                                    const float size = 3.0))
+
+/// @brief   get an osg node that takes over the arrays of the points
+/// @param   locations The locations - moved into the vertex array, not copied
+/// @param   colors The color of each location, or a single color for all of
+///          them - moved into the color array, not copied
+/// @param   size The size of all the points
+///
+/// Fill these instead of a PointVec_t and the cloud reaches the display
+/// without being copied at all:
+/// @code
+/// std::vector<osg::Vec3f> locations;
+/// std::vector<osg::Vec4ub> colors;
+/// ... fill them ...
+/// d3::di().add("scan", d3::get(std::move(locations), std::move(colors)));
+/// @endcode
+D3_DECL(osg::ref_ptr<osg::Node> get(std::vector<osg::Vec3f>&& locations,
+                                    std::vector<osg::Vec4ub>&& colors,
+                                    const float size = 3.0))
 
 /// @brief   get an osg node
 /// @param   point The point to add
@@ -42,7 +99,11 @@ osg::ref_ptr<osg::Node> get(const PointVec_t& points,
 inline osg::ref_ptr<osg::Node> get(const Point& point,
                                    const float size = 3.0)
 {
+#ifdef   D3_DISABLE
+    return nullptr;
+#else    // D3_DISABLE
     return get(PointVec_t(1, point), size);
+#endif   // D3_DISABLE
 };
 
 } // namespace d3
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Vec3>
 #include <osg/Vec4>
 #include <osg/Node>
@@ -38,7 +40,7 @@ typedef std::vector<Sphere> SphereVec_t;
 /// @brief   Create an osg::Node from a vector of spheres
 /// @param   spheres The vector of spheres to create the node from
 /// @return  osg::ref_ptr<osg::Node> The displayable node
-osg::ref_ptr<osg::Node> get(const SphereVec_t& spheres);
+D3_DECL(osg::ref_ptr<osg::Node> get(const SphereVec_t& spheres))
 
 /// @brief   Create an osg::Node from a single sphere
 /// @param   sphere The sphere to create the node from
@@ -0,0 +1,387 @@
+/////////////////////////////////////////////////////////////////
+/// @file      Traits.h
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Draw containers of your own point, line and pose types
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Colors.h"
+#include "Lines.h"
+#include "Points.h"
+#include "Triads.h"
+
+#include <osg/Matrixd>
+#include <osg/Vec3f>
+#include <osg/Vec4ub>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace d3
+{
+
+/// @brief   How the builders read the types in a container
+///
+/// Each trait has a static get() and is found at compile time, so a container
+/// of your own types goes straight into the osg arrays with no vector of
+/// d3::Point (or d3::Line, d3::Triad) in between:
+/// @code
+/// std::vector<pcl::PointXYZRGB> cloud( ... );
+/// d3::di().add("cloud", d3::get(cloud));
+///
+/// std::vector<Eigen::Isometry3d> poses( ... );
+/// d3::di().add("poses", d3::get(poses, 0.5));
+/// @endcode
+/// Anything that doesn't look like one of the types below gets a
+/// specialization:
+/// @code
+/// template<>
+/// struct d3::traits::position<my::Sample>
+/// {
+///     static osg::Vec3f get(const my::Sample& sample) { return osg::Vec3f(sample.pos[0], sample.pos[1], sample.pos[2]); };
+/// };
+/// @endcode
+namespace traits
+{
+
+namespace detail
+{
+/// @brief   void if all the types are well formed (to find members)
+template<typename...>
+struct voider
+{
+    typedef void type;
+};
+
+/// @brief   The alpha of an r, g, b (and a) color
+template<typename T>
+auto alpha(const T& item, int) -> decltype(static_cast<unsigned char>(item.a))
+{
+    return static_cast<unsigned char>(item.a);
+}
+
+/// @brief   Opaque if there is no alpha
+template<typename T>
+unsigned char alpha(const T&, long)
+{
+    return 255;
+}
+} // namespace detail
+
+/// @brief   The location of a point: static osg::Vec3f get(const T&)
+///
+/// Given for d3::Point, types with x, y and z members (PCL points) and types
+/// with x(), y() and z() (osg and Eigen vectors).
+template<typename T, typename Enable = void>
+struct position;
+
+/// @brief   The location of a d3::Point
+template<>
+struct position<Point>
+{
+    static osg::Vec3f get(const Point& point) { return point.location; };
+};
+
+/// @brief   The location of a point with x, y and z members
+template<typename T>
+struct position<T, typename detail::voider<decltype(std::declval<const T&>().x),
+                                           decltype(std::declval<const T&>().y),
+                                           decltype(std::declval<const T&>().z)>::type>
+{
+    static osg::Vec3f get(const T& point) { return osg::Vec3f(point.x, point.y, point.z); };
+};
+
+/// @brief   The location of a vector with x(), y() and z()
+template<typename T>
+struct position<T, typename detail::voider<decltype(std::declval<const T&>().x()),
+                                           decltype(std::declval<const T&>().y()),
+                                           decltype(std::declval<const T&>().z())>::type>
+{
+    static osg::Vec3f get(const T& point) { return osg::Vec3f(point.x(), point.y(), point.z()); };
+};
+
+/// @brief   The color of a point or line: static osg::Vec4ub get(const T&)
+///
+/// Given for types with an osg::Vec4 color member (d3::Point, d3::Line, ...)
+/// and types with r, g and b (and a) byte members (PCL points). Types without
+/// one are drawn white.
+template<typename T, typename Enable = void>
+struct color;
+
+/// @brief   The color of a type with a color member
+template<typename T>
+struct color<T, typename detail::voider<decltype(toBytes(std::declval<const T&>().color))>::type>
+{
+    static osg::Vec4ub get(const T& item) { return toBytes(item.color); };
+};
+
+/// @brief   The color of a type with r, g and b members
+template<typename T>
+struct color<T, typename detail::voider<decltype(std::declval<const T&>().r),
+                                        decltype(std::declval<const T&>().g),
+                                        decltype(std::declval<const T&>().b)>::type>
+{
+    static osg::Vec4ub get(const T& item) { return osg::Vec4ub(item.r, item.g, item.b, detail::alpha(item, 0)); };
+};
+
+/// @brief   The two ends of a line: static osg::Vec3f begin(const T&) and
+///          static osg::Vec3f end(const T&)
+///
+/// Given for d3::Line and pairs of anything with a position.
+template<typename T, typename Enable = void>
+struct endpoints;
+
+/// @brief   The ends of a d3::Line
+template<>
+struct endpoints<Line>
+{
+    static osg::Vec3f begin(const Line& line) { return line.begin; };
+    static osg::Vec3f end(const Line& line)   { return line.end; };
+};
+
+/// @brief   The ends of a pair of positions
+template<typename A, typename B>
+struct endpoints<std::pair<A, B>,
+                 typename detail::voider<decltype(position<A>::get(std::declval<const A&>())),
+                                         decltype(position<B>::get(std::declval<const B&>()))>::type>
+{
+    static osg::Vec3f begin(const std::pair<A, B>& line) { return position<A>::get(line.first); };
+    static osg::Vec3f end(const std::pair<A, B>& line)   { return position<B>::get(line.second); };
+};
+
+/// @brief   The pose of a triad: static osg::Matrixd get(const T&)
+///
+/// Given for d3::Triad, osg::Matrixd and types with a 4x4 matrix() taking
+/// column vectors (Eigen transforms and matrices).
+template<typename T, typename Enable = void>
+struct pose;
+
+/// @brief   The pose of a d3::Triad
+template<>
+struct pose<Triad>
+{
+    static osg::Matrixd get(const Triad& triad) { return triad.pose; };
+};
+
+/// @brief   The pose of an osg matrix
+template<>
+struct pose<osg::Matrixd>
+{
+    static osg::Matrixd get(const osg::Matrixd& matrix) { return matrix; };
+};
+
+/// @brief   The pose of a transform with a matrix()
+template<typename T>
+struct pose<T, typename detail::voider<decltype(std::declval<const T&>().matrix()(3, 3))>::type>
+{
+    static osg::Matrixd get(const T& transform)
+    {
+        // osg multiplies row vectors, so its matrices are transposed
+        osg::Matrixd matrix;
+        for ( int row(0) ; row<4 ; ++row )
+            for ( int col(0) ; col<4 ; ++col )
+                matrix(row, col) = transform.matrix()(col, row);
+        return matrix;
+    };
+};
+
+/// @{
+/// @name    Which of the traits a type has
+template<typename T, typename Enable = void> struct has_position : std::false_type {};
+template<typename T>
+struct has_position<T, typename detail::voider<decltype(position<T>::get(std::declval<const T&>()))>::type> : std::true_type {};
+
+template<typename T, typename Enable = void> struct has_color : std::false_type {};
+template<typename T>
+struct has_color<T, typename detail::voider<decltype(color<T>::get(std::declval<const T&>()))>::type> : std::true_type {};
+
+template<typename T, typename Enable = void> struct has_endpoints : std::false_type {};
+template<typename T>
+struct has_endpoints<T, typename detail::voider<decltype(endpoints<T>::begin(std::declval<const T&>()))>::type> : std::true_type {};
+
+template<typename T, typename Enable = void> struct has_pose : std::false_type {};
+template<typename T>
+struct has_pose<T, typename detail::voider<decltype(pose<T>::get(std::declval<const T&>()))>::type> : std::true_type {};
+/// @}
+
+/// The type in a container
+template<typename Container>
+using element_t = typename std::decay<decltype(*std::begin(std::declval<const Container&>()))>::type;
+
+/// @{
+/// @name    What a container is drawn as - points first, then lines, then
+///          triads
+template<typename Container, typename Enable = void> struct is_points : std::false_type {};
+template<typename Container>
+struct is_points<Container, typename detail::voider<element_t<Container>>::type>
+    : std::integral_constant<bool, has_position<element_t<Container>>::value> {};
+
+template<typename Container, typename Enable = void> struct is_lines : std::false_type {};
+template<typename Container>
+struct is_lines<Container, typename detail::voider<element_t<Container>>::type>
+    : std::integral_constant<bool, not is_points<Container>::value &&
+                                   has_endpoints<element_t<Container>>::value> {};
+
+template<typename Container, typename Enable = void> struct is_triads : std::false_type {};
+template<typename Container>
+struct is_triads<Container, typename detail::voider<element_t<Container>>::type>
+    : std::integral_constant<bool, not is_points<Container>::value &&
+                                   not is_lines<Container>::value &&
+                                   has_pose<element_t<Container>>::value> {};
+/// @}
+
+} // namespace traits
+
+namespace detail
+{
+/// @brief   The size of a container, to reserve for it (0 if it has none)
+template<typename Container>
+auto sizeOf(const Container& container, int) -> decltype(static_cast<size_t>(container.size()))
+{
+    return static_cast<size_t>(container.size());
+}
+
+/// @brief   The size of a container without a size()
+template<typename Container>
+size_t sizeOf(const Container&, long)
+{
+    return 0;
+}
+
+/// @brief   Read the colors of a container of colored types
+template<typename T, typename Container>
+typename std::enable_if<traits::has_color<T>::value>::type
+fillColors(const Container& items, const size_t& perItem, std::vector<osg::Vec4ub>& colors)
+{
+    colors.reserve(perItem*sizeOf(items, 0));
+    for ( const auto& item : items )
+        colors.insert(colors.end(), perItem, traits::color<T>::get(item));
+}
+
+/// @brief   One white for a container of types without colors
+template<typename T, typename Container>
+typename std::enable_if<not traits::has_color<T>::value>::type
+fillColors(const Container&, const size_t&, std::vector<osg::Vec4ub>& colors)
+{
+    colors.assign(1, osg::Vec4ub(255, 255, 255, 255));
+}
+
+/// @brief   Read the locations and colors of a container of points
+template<typename Container>
+void fillPoints(const Container& points,
+                std::vector<osg::Vec3f>& locations,
+                std::vector<osg::Vec4ub>& colors)
+{
+    typedef traits::element_t<Container> Point_t;
+    locations.reserve(sizeOf(points, 0));
+    for ( const auto& point : points )
+        locations.push_back(traits::position<Point_t>::get(point));
+    fillColors<Point_t>(points, 1, colors);
+}
+
+/// @brief   Read the ends and colors of a container of lines
+template<typename Container>
+void fillLines(const Container& lines,
+               std::vector<osg::Vec3f>& ends,
+               std::vector<osg::Vec4ub>& colors)
+{
+    typedef traits::element_t<Container> Line_t;
+    ends.reserve(2*sizeOf(lines, 0));
+    for ( const auto& line : lines )
+    {
+        ends.push_back(traits::endpoints<Line_t>::begin(line));
+        ends.push_back(traits::endpoints<Line_t>::end(line));
+    }
+    fillColors<Line_t>(lines, 2, colors);
+}
+
+/// @brief   Make the axes of a container of poses
+template<typename Container>
+void fillTriads(const Container& poses,
+                const double& scale,
+                std::vector<osg::Vec3f>& ends,
+                std::vector<osg::Vec4ub>& colors)
+{
+    typedef traits::element_t<Container> Pose_t;
+    static const osg::Vec4ub axisColors[3] = { osg::Vec4ub(255, 0, 0, 255),
+                                               osg::Vec4ub(0, 255, 0, 255),
+                                               osg::Vec4ub(0, 0, 255, 255) };
+    ends.reserve(6*sizeOf(poses, 0));
+    colors.reserve(6*sizeOf(poses, 0));
+    for ( const auto& item : poses )
+    {
+        const osg::Matrixd pose( traits::pose<Pose_t>::get(item) );
+        for ( int axis(0) ; axis<3 ; ++axis )
+        {
+            // a short tail behind the origin, the full length in front
+            osg::Vec3d tail, head;
+            tail[axis] = -0.1*scale;
+            head[axis] =  1.0*scale;
+            ends.push_back(tail * pose);
+            ends.push_back(head * pose);
+            colors.insert(colors.end(), 2, axisColors[axis]);
+        }
+    }
+}
+} // namespace detail
+
+/// @brief   get an osg node from a container of any point type
+/// @param   points The points (anything with a traits::position)
+/// @param   size The size of all the points
+template<typename Container>
+typename std::enable_if<traits::is_points<Container>::value, osg::ref_ptr<osg::Node>>::type
+get(const Container& points,
+    const float size = 3.0)
+{
+#ifdef   D3_DISABLE
+    return nullptr;
+#else    // D3_DISABLE
+    std::vector<osg::Vec3f> locations;
+    std::vector<osg::Vec4ub> colors;
+    detail::fillPoints(points, locations, colors);
+    return get(std::move(locations), std::move(colors), size);
+#endif   // D3_DISABLE
+};
+
+/// @brief   get an osg node from a container of any line type
+/// @param   lines The lines (anything with traits::endpoints)
+template<typename Container>
+typename std::enable_if<traits::is_lines<Container>::value, osg::ref_ptr<osg::Node>>::type
+get(const Container& lines)
+{
+#ifdef   D3_DISABLE
+    return nullptr;
+#else    // D3_DISABLE
+    std::vector<osg::Vec3f> ends;
+    std::vector<osg::Vec4ub> colors;
+    detail::fillLines(lines, ends, colors);
+    return getLines(std::move(ends), std::move(colors));
+#endif   // D3_DISABLE
+};
+
+/// @brief   get an osg node from a container of any pose type
+/// @param   poses The poses to draw triads at (anything with a traits::pose)
+/// @param   scale The length of the axes
+template<typename Container>
+typename std::enable_if<traits::is_triads<Container>::value, osg::ref_ptr<osg::Node>>::type
+get(const Container& poses,
+    const double& scale = 1.0)
+{
+#ifdef   D3_DISABLE
+    return nullptr;
+#else    // D3_DISABLE
+    std::vector<osg::Vec3f> ends;
+    std::vector<osg::Vec4ub> colors;
+    detail::fillTriads(poses, scale, ends, colors);
+    return getLines(std::move(ends), std::move(colors));
+#endif   // D3_DISABLE
+};
+
+} // namespace d3
@@ -9,9 +9,7 @@
 /////////////////////////////////////////////////////////////////
 
 #include "Triads.h"
-#include "Lines.h"
-
-#include <osg/Geometry>
+#include "Traits.h"
 
 namespace d3
 {
@@ -21,36 +19,11 @@ namespace d3
 osg::ref_ptr<osg::Node> get(const TriadVec_t& triads,
                             const double& scale /* = 1.0 */)
 {
-    LineVec_t lines;
-
-    for ( const auto& triad : triads )
-    {
-        // x-axis
-        lines.push_back
-            ({
-                osg::Vec3d(-0.1*scale,  0.0,  0.0) * triad.pose,
-                osg::Vec3d( 1.0*scale,  0.0,  0.0) * triad.pose,
-                osg::Vec4( 1.0,  0.0,  0.0, 1.0)
-            });
-
-        // y-axis
-        lines.push_back
-            ({
-                osg::Vec3d( 0.0, -0.1*scale,  0.0) * triad.pose,
-                osg::Vec3d( 0.0,  1.0*scale,  0.0) * triad.pose,
-                osg::Vec4( 0.0,  1.0,  0.0, 1.0)
-            });
-
-        // z-axis
-        lines.push_back
-            ({
-                osg::Vec3d( 0.0, 0.0,-0.1*scale) * triad.pose,
-                osg::Vec3d( 0.0, 0.0, 1.0*scale) * triad.pose,
-                osg::Vec4( 0.0, 0.0, 1.0, 1.0)
-            });
-    }
-
-    return get(lines);
+    // the axes go straight into the arrays handed to GL
+    std::vector<osg::Vec3f> ends;
+    std::vector<osg::Vec4ub> colors;
+    detail::fillTriads(triads, scale, ends, colors);
+    return getLines(std::move(ends), std::move(colors));
 };
 
 } // namespace d3
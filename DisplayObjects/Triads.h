@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Node>
 #include <vector>
 
@@ -35,7 +37,7 @@ typedef std::vector<Triad> TriadVec_t;
 
 /// @brief   get an osg node from a vector of triads
 /// @param   triads The triads we should draw
-osg::ref_ptr<osg::Node> get(const TriadVec_t& grids, const double& scale = 1.0);
+D3_DECL(osg::ref_ptr<osg::Node> get(const TriadVec_t& grids, const double& scale = 1.0))
 
 /// @brief   get an osg node from a single triad
 /// @param   triad The triad that we should draw
@@ -8,6 +8,7 @@
 /// @attention All rights reserved
 /////////////////////////////////////////////////////////////////
 
+#include "Colors.h"
 #include "Voxels.h"
 #include "Lines.h"
 
@@ -15,115 +16,123 @@
 #include <osg/Version>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
 
 namespace d3
 {
 
+namespace
+{
+
+/// The corners at the ends of the 12 edges of a cell - corners 0-3 go around
+/// the bottom and 4-7 around the top
+static const unsigned int edgeCorners[12][2] = { {4, 5}, {5, 6}, {6, 7}, {7, 4},   // top
+                                                 {0, 4}, {1, 5}, {2, 6}, {3, 7},   // bottom-to-top
+                                                 {0, 1}, {1, 2}, {2, 3}, {3, 0} }; // bottom
+
+/// An arbitrary scale for comparison - edges the same to 1/scale are the same
+static const double edgeScale(1000.0);
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A corner of a cell
+/////////////////////////////////////////////////////////////////
+osg::Vec3d corner(const Voxel& voxel,
+                  const unsigned int& index)
+{
+    const bool maxX( (1 == index%4) || (2 == index%4) );
+    const bool maxY( 2 <= index%4 );
+    return osg::Vec3d(maxX ? voxel.maxCorner.x() : voxel.minCorner.x(),
+                      maxY ? voxel.maxCorner.y() : voxel.minCorner.y(),
+                      (4 <= index) ? voxel.maxCorner.z() : voxel.minCorner.z());
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   An edge of a cell with its ends quantized, the lesser end first
+///          so an edge and its reverse have the same key
+///
+/// The ends are kept to 1/edgeScale in 32 bits (a couple of thousand km
+/// either way, like before), which keeps an edge at 28 bytes.
+/////////////////////////////////////////////////////////////////
+struct Edge
+{
+    /// @brief   Constructor
+    /// @param   begin One end
+    /// @param   end The other end
+    /// @param   theId The cell and edge it came from (12*cell + edge)
+    Edge(const osg::Vec3d& begin,
+         const osg::Vec3d& end,
+         const uint32_t& theId) :
+        key(),
+        id(theId)
+    {
+        int32_t ends[2][3];
+        for ( int ii(0) ; ii<3 ; ++ii )
+        {
+            ends[0][ii] = static_cast<int32_t>(std::lround(begin[ii]*edgeScale));
+            ends[1][ii] = static_cast<int32_t>(std::lround(end[ii]*edgeScale));
+        }
+        const bool swap( std::lexicographical_compare(ends[1], ends[1] + 3, ends[0], ends[0] + 3) );
+        std::copy(ends[swap ? 1 : 0], ends[swap ? 1 : 0] + 3, key);
+        std::copy(ends[swap ? 0 : 1], ends[swap ? 0 : 1] + 3, key + 3);
+    };
+
+    /// @brief   Same edge
+    bool same(const Edge& other) const
+    {
+        return std::equal(key, key + 6, other.key);
+    };
+
+    /// @brief   By the edge, then by where it came from
+    bool operator<(const Edge& other) const
+    {
+        if ( not same(other) ) return std::lexicographical_compare(key, key + 6, other.key, other.key + 6);
+        return id < other.id;
+    };
+
+    /// The quantized ends
+    int32_t  key[6];
+
+    /// The cell and edge it came from
+    uint32_t id;
+};
+
+} // namespace
+
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 osg::ref_ptr<osg::Node> get(const VoxelVec_t& voxels)
 {
-    // here are all the edges of all the cells
-    LineVec_t cellEdges;
-    cellEdges.reserve( cellEdges.size() + voxels.size() );
-    
-    for ( const auto& vv : voxels )
+    // every edge of every cell in a single array, sorted so the copies of an
+    // edge (a neighbor's, either way around) sit together with the first
+    // cell's copy in front - one allocation however many cells there are
+    std::vector<Edge> edges;
+    edges.reserve(12*voxels.size());
+    for ( size_t vv(0) ; vv<voxels.size() ; ++vv )
+        for ( unsigned int ee(0) ; ee<12 ; ++ee )
+            edges.emplace_back(corner(voxels[vv], edgeCorners[ee][0]),
+                               corner(voxels[vv], edgeCorners[ee][1]),
+                               static_cast<uint32_t>(12*vv + ee));
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end(),
+                            [](const Edge& edge0, const Edge& edge1) { return edge0.same(edge1); }),
+                edges.end());
+
+    // then the ends and colors go straight into the arrays handed to GL
+    std::vector<osg::Vec3f> ends(2*edges.size());
+    std::vector<osg::Vec4ub> colors(2*edges.size());
+    for ( size_t ii(0) ; ii<edges.size() ; ++ii )
     {
-        // make the 8 corners of the cell
-        osg::Vec3d corner0(vv.minCorner.x(), vv.minCorner.y(), vv.minCorner.z());
-        osg::Vec3d corner1(vv.maxCorner.x(), vv.minCorner.y(), vv.minCorner.z());
-        osg::Vec3d corner2(vv.maxCorner.x(), vv.maxCorner.y(), vv.minCorner.z());
-        osg::Vec3d corner3(vv.minCorner.x(), vv.maxCorner.y(), vv.minCorner.z());
-        osg::Vec3d corner4(vv.minCorner.x(), vv.minCorner.y(), vv.maxCorner.z());
-        osg::Vec3d corner5(vv.maxCorner.x(), vv.minCorner.y(), vv.maxCorner.z());
-        osg::Vec3d corner6(vv.maxCorner.x(), vv.maxCorner.y(), vv.maxCorner.z());
-        osg::Vec3d corner7(vv.minCorner.x(), vv.maxCorner.y(), vv.maxCorner.z());
-
-        // top of this cell
-        cellEdges.emplace_back(Line{corner4, corner5, vv.color});
-        cellEdges.emplace_back(Line{corner5, corner6, vv.color});
-        cellEdges.emplace_back(Line{corner6, corner7, vv.color});
-        cellEdges.emplace_back(Line{corner7, corner4, vv.color});
-
-        // bottom-to-top for this cell
-        cellEdges.emplace_back(Line{corner0, corner4, vv.color});
-        cellEdges.emplace_back(Line{corner1, corner5, vv.color});
-        cellEdges.emplace_back(Line{corner2, corner6, vv.color});
-        cellEdges.emplace_back(Line{corner3, corner7, vv.color});
-        
-        // bottom of this cell
-        cellEdges.emplace_back(Line{corner0, corner1, vv.color});
-        cellEdges.emplace_back(Line{corner1, corner2, vv.color});
-        cellEdges.emplace_back(Line{corner2, corner3, vv.color});
-        cellEdges.emplace_back(Line{corner3, corner0, vv.color});
+        const Voxel& voxel( voxels[edges[ii].id/12] );
+        const unsigned int* edge( edgeCorners[edges[ii].id%12] );
+        ends[2*ii] = corner(voxel, edge[0]);
+        ends[2*ii + 1] = corner(voxel, edge[1]);
+        colors[2*ii] = colors[2*ii + 1] = toBytes(voxel.color);
     }
+    edges = std::vector<Edge>();
 
-    // sort the edges so we can remove duplicates
-    std::sort(cellEdges.begin(), cellEdges.end(),
-              [](const Line& edge0, const Line& edge1)
-              {
-                  osg::Vec3d mid0( (edge0.begin + edge0.end)/2.0 );
-                  double dist0( mid0.x()*mid0.x() + mid0.y()*mid0.y() + mid0.z()*mid0.z() );
-
-                  osg::Vec3d mid1( (edge1.begin + edge1.end)/2.0 );
-                  double dist1( mid1.x()*mid1.x() + mid1.y()*mid1.y() + mid1.z()*mid1.z() );
-                  return (dist0 < dist1);
-              });
-
-    // now uniquify the edges
-    auto newEndIter =
-        std::unique(cellEdges.begin(), cellEdges.end(),
-                    [](const Line& edge0, const Line& edge1)
-                    {
-                        // the beginning and end of the two edges
-                        const auto& b0( edge0.begin );
-                        const auto& e0( edge0.end );
-                        const auto& b1( edge1.begin );
-                        const auto& e1( edge1.end );
-
-                        // an arbitrary scale for comparison
-                        static const double scale(1000.0);
-
-                        // The "int" version of of the beginning/end * scale
-                        const int b0x( static_cast<int>(b0.x() * scale) );
-                        const int b0y( static_cast<int>(b0.y() * scale) );
-                        const int b0z( static_cast<int>(b0.z() * scale) );
-                        const int e0x( static_cast<int>(e0.x() * scale) );
-                        const int e0y( static_cast<int>(e0.y() * scale) );
-                        const int e0z( static_cast<int>(e0.z() * scale) );
-
-                        const int b1x( static_cast<int>(b1.x() * scale) );
-                        const int b1y( static_cast<int>(b1.y() * scale) );
-                        const int b1z( static_cast<int>(b1.z() * scale) );
-                        const int e1x( static_cast<int>(e1.x() * scale) );
-                        const int e1y( static_cast<int>(e1.y() * scale) );
-                        const int e1z( static_cast<int>(e1.z() * scale) );
-
-                        // see if the beginning of the edge and end of the
-                        // edge are the same (accurate to 1/scale
-                        if ( (b0x == b1x) && (b0y == b1y) && (b0z == b1z) &&
-                             (e0x == e1x) && (e0y == e1y) && (e0z == e1z) )
-                        {
-                            // these are the same edge
-                            return true;
-                        }
-
-                        // check if the edge are the same, but just reversed
-                        if ( (b0x == e1x) && (b0y == e1y) && (b0z == e1z) &&
-                             (e0x == b1x) && (e0y == b1y) && (e0z == b1z) )
-                        {
-                            return true;
-                        }
-
-                        // these are not the same edge
-                        return false;
-                    });
-    
-     // remove the duplicates
-    cellEdges.resize( std::distance(cellEdges.begin(), newEndIter) );
-
-    // return the created edges as voxels
-    return get(cellEdges);
+    return getLines(std::move(ends), std::move(colors));
 };
 
 } // namespace d3
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "Disable.h"
+
 #include <osg/Vec3d>
 #include <osg/Vec4>
 #include <osg/Node>
@@ -40,7 +42,7 @@ typedef std::vector<Voxel> VoxelVec_t;
 /// @brief   get an osg node from a vector of voxels
 /// @param   voxels The voxels we should draw
 /// @return  The constructed node
-osg::ref_ptr<osg::Node> get(const VoxelVec_t& voxels);
+D3_DECL(osg::ref_ptr<osg::Node> get(const VoxelVec_t& voxels))
 
 /// @brief   get an osg node from a single voxel
 /// @param   voxel the voxel that we should draw
@@ -0,0 +1,88 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchAppend.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Measure streaming a point at a time onto a name
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Grids.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <osg/Geode>
+#include <osg/NodeVisitor>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Counts the geodes and drawables in a scene
+/////////////////////////////////////////////////////////////////
+class CountDrawables : public osg::NodeVisitor
+{
+  public:
+
+    /// @brief   Constructor
+    CountDrawables() :
+        osg::NodeVisitor(osg::NodeVisitor::TRAVERSE_ALL_CHILDREN),
+        geodes(0),
+        drawables(0)
+    {
+    };
+
+    /// @brief   Count a geode
+    virtual void apply(osg::Geode& geode)
+    {
+        ++geodes;
+        drawables += geode.getNumDrawables();
+    };
+
+    /// The number of geodes
+    size_t geodes;
+
+    /// The number of drawables (draw calls)
+    size_t drawables;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    static const size_t numAppends(1000000);
+
+    d3::di().add( "ground", d3::ground() );
+    d3::di().flush().wait();
+
+    // a spiral trail, one point per add
+    static const bool replace(false);
+    const auto start( std::chrono::steady_clock::now() );
+    for ( size_t ii(0) ; ii<numAppends ; ++ii )
+    {
+        const double tt( 0.001*ii );
+        d3::di().add( "trail",
+                      d3::get(d3::Point{osg::Vec3d(0.1*tt*std::cos(tt), 0.1*tt*std::sin(tt), 0.001*tt), d3::white()}),
+                      replace );
+    }
+    d3::di().flush().wait();
+    const auto stop( std::chrono::steady_clock::now() );
+
+    CountDrawables counter;
+    d3::di().lock();
+    osg::ref_ptr<osg::Node> root( d3::di().getRootGroup() );
+    if ( root ) root->accept(counter);
+    d3::di().unlock();
+
+    std::cout << numAppends << " appends: "
+              << std::chrono::duration<double>(stop - start).count() << " s, "
+              << counter.geodes << " geodes, "
+              << counter.drawables << " drawables in the scene" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchBackends.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Measure the cost of a call into the display interface for each
+///            backend
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Time a number of adds of the same node
+/// @param   label What to print
+/// @param   backend The backend to use
+/// @param   count The number of adds
+/// @param   node The node to add
+/////////////////////////////////////////////////////////////////
+void bench(const std::string& label,
+           const d3::Backend& backend,
+           const size_t& count,
+           const osg::ref_ptr<osg::Node>& node)
+{
+    d3::setBackend(backend);
+
+    const auto start( std::chrono::steady_clock::now() );
+    for ( size_t ii(0) ; ii<count ; ++ii )
+        d3::di().add( "bench::point", node );
+    const auto stop( std::chrono::steady_clock::now() );
+
+    std::cout << label << ": "
+              << std::chrono::duration<double, std::nano>(stop - start).count() / count
+              << " ns/add" << std::endl;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    // built once up front - this measures the call, not the geometry
+    d3::PointVec_t points;
+    for ( double xx(-1.0) ; xx<=1.0 ; xx+=0.01 )
+        points.push_back(d3::Point{{xx, 0.0, 0.0}, d3::white()});
+    const osg::ref_ptr<osg::Node> node( d3::get(points) );
+
+    // none first, it must not start the display
+    bench("none   ", d3::Backend::NONE,  10000000, node);
+    std::cout << "display running after none: " << std::boolalpha << d3::di().running() << std::endl;
+
+    bench("stats  ", d3::Backend::STATS, 1000000, node);
+    const d3::DisplayInterface::Stats_t stats( d3::di().getStats() );
+    for ( const auto& entry : stats )
+        std::cout << "  " << entry.first << ": " << entry.second.calls << " calls, "
+                  << entry.second.bytes << " bytes" << std::endl;
+
+    // the display includes waiting on the display thread when the queue fills
+    bench("display", d3::Backend::DISPLAY, 100000, node);
+    d3::di().flush().wait();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchBuilders.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Measure the time, peak heap and allocations of the grid, triad
+///            and voxel builders against going through a LineVec_t
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayObjects/Grids.h>
+#include <DDDisplayObjects/Lines.h>
+#include <DDDisplayObjects/Triads.h>
+#include <DDDisplayObjects/Voxels.h>
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace
+{
+
+/// The heap bytes in use, and the most since the last reset
+std::atomic<size_t> liveBytes(0);
+std::atomic<size_t> peakBytes(0);
+
+/// The allocations made
+std::atomic<size_t> allocations(0);
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Count an allocation
+/////////////////////////////////////////////////////////////////
+void* counted(void* memory)
+{
+    if ( nullptr == memory ) return memory;
+    ++allocations;
+    const size_t live( liveBytes += malloc_usable_size(memory) );
+    size_t peak( peakBytes );
+    while ( (live > peak) && not peakBytes.compare_exchange_weak(peak, live) ) {}
+    return memory;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Time a build and find its peak heap above what was in use and
+///          the number of allocations it made
+/////////////////////////////////////////////////////////////////
+void measure(const std::string& name,
+             const std::function<osg::ref_ptr<osg::Node>()>& build)
+{
+    const size_t before( liveBytes );
+    const size_t allocated( allocations );
+    peakBytes = before;
+    const auto start( std::chrono::steady_clock::now() );
+    osg::ref_ptr<osg::Node> node( build() );
+    const double seconds( std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() );
+    std::cout << "  " << name << ": " << seconds*1e3 << " ms, peak "
+              << (peakBytes - before)/(1024.0*1024.0) << " MB in "
+              << (allocations - allocated) << " allocations"
+              << (node ? "" : " (failed)") << std::endl;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The voxels the way they were built before, through a LineVec_t
+///          sorted and made unique
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> throughLines(const d3::VoxelVec_t& voxels)
+{
+    // here are all the edges of all the cells
+    d3::LineVec_t cellEdges;
+    cellEdges.reserve( cellEdges.size() + voxels.size() );
+
+    for ( const auto& vv : voxels )
+    {
+        // make the 8 corners of the cell
+        osg::Vec3d corner0(vv.minCorner.x(), vv.minCorner.y(), vv.minCorner.z());
+        osg::Vec3d corner1(vv.maxCorner.x(), vv.minCorner.y(), vv.minCorner.z());
+        osg::Vec3d corner2(vv.maxCorner.x(), vv.maxCorner.y(), vv.minCorner.z());
+        osg::Vec3d corner3(vv.minCorner.x(), vv.maxCorner.y(), vv.minCorner.z());
+        osg::Vec3d corner4(vv.minCorner.x(), vv.minCorner.y(), vv.maxCorner.z());
+        osg::Vec3d corner5(vv.maxCorner.x(), vv.minCorner.y(), vv.maxCorner.z());
+        osg::Vec3d corner6(vv.maxCorner.x(), vv.maxCorner.y(), vv.maxCorner.z());
+        osg::Vec3d corner7(vv.minCorner.x(), vv.maxCorner.y(), vv.maxCorner.z());
+
+        // top of this cell
+        cellEdges.emplace_back(d3::Line{corner4, corner5, vv.color});
+        cellEdges.emplace_back(d3::Line{corner5, corner6, vv.color});
+        cellEdges.emplace_back(d3::Line{corner6, corner7, vv.color});
+        cellEdges.emplace_back(d3::Line{corner7, corner4, vv.color});
+
+        // bottom-to-top for this cell
+        cellEdges.emplace_back(d3::Line{corner0, corner4, vv.color});
+        cellEdges.emplace_back(d3::Line{corner1, corner5, vv.color});
+        cellEdges.emplace_back(d3::Line{corner2, corner6, vv.color});
+        cellEdges.emplace_back(d3::Line{corner3, corner7, vv.color});
+
+        // bottom of this cell
+        cellEdges.emplace_back(d3::Line{corner0, corner1, vv.color});
+        cellEdges.emplace_back(d3::Line{corner1, corner2, vv.color});
+        cellEdges.emplace_back(d3::Line{corner2, corner3, vv.color});
+        cellEdges.emplace_back(d3::Line{corner3, corner0, vv.color});
+    }
+
+    // sort the edges so we can remove duplicates
+    std::sort(cellEdges.begin(), cellEdges.end(),
+              [](const d3::Line& edge0, const d3::Line& edge1)
+              {
+                  osg::Vec3d mid0( (edge0.begin + edge0.end)/2.0 );
+                  double dist0( mid0.x()*mid0.x() + mid0.y()*mid0.y() + mid0.z()*mid0.z() );
+
+                  osg::Vec3d mid1( (edge1.begin + edge1.end)/2.0 );
+                  double dist1( mid1.x()*mid1.x() + mid1.y()*mid1.y() + mid1.z()*mid1.z() );
+                  return (dist0 < dist1);
+              });
+
+    // now uniquify the edges, the same to 1/scale either way around
+    auto newEndIter =
+        std::unique(cellEdges.begin(), cellEdges.end(),
+                    [](const d3::Line& edge0, const d3::Line& edge1)
+                    {
+                        static const double scale(1000.0);
+                        auto same = [](const osg::Vec3d& one, const osg::Vec3d& other)
+                            {
+                                return (static_cast<int>(one.x() * scale) == static_cast<int>(other.x() * scale)) &&
+                                       (static_cast<int>(one.y() * scale) == static_cast<int>(other.y() * scale)) &&
+                                       (static_cast<int>(one.z() * scale) == static_cast<int>(other.z() * scale));
+                            };
+                        return (same(edge0.begin, edge1.begin) && same(edge0.end, edge1.end)) ||
+                               (same(edge0.begin, edge1.end) && same(edge0.end, edge1.begin));
+                    });
+
+    // remove the duplicates
+    cellEdges.resize( std::distance(cellEdges.begin(), newEndIter) );
+
+    // return the created edges as voxels
+    return d3::get(cellEdges);
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Every allocation of the program is counted
+/////////////////////////////////////////////////////////////////
+void* operator new(size_t bytes)
+{
+    void* memory( counted(std::malloc(bytes ? bytes : 1)) );
+    if ( nullptr == memory ) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept
+{
+    return counted(std::malloc(bytes ? bytes : 1));
+}
+
+void operator delete(void* memory) noexcept
+{
+    if ( nullptr == memory ) return;
+    liveBytes -= malloc_usable_size(memory);
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    operator delete(memory);
+}
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    // the cells of the example program
+    d3::VoxelVec_t cells;
+    const osg::Vec3d halfCell{0.1, 0.1, 0.5};
+    for ( double xx(10.0) ; xx<=20.0 ; xx+=0.1 )
+        for ( double yy(10.0) ; yy<=15.0 ; yy+=0.1 )
+            for ( double zz(0.0) ; zz<=5.0 ; zz+=0.5 )
+                cells.emplace_back(d3::Voxel{osg::Vec3d{xx,yy,zz}-halfCell,
+                                             osg::Vec3d{xx,yy,zz}+halfCell,
+                                             {1.0, 1.0, 0.0, 1.0}});
+    std::cout << cells.size() << " voxels" << std::endl;
+    measure("get(VoxelVec_t)", [&]() { return d3::get(cells); });
+    measure("through LineVec_t", [&]() { return throughLines(cells); });
+
+    // a fine grid
+    const d3::GridVec_t grids(1, d3::Grid{osg::Vec2(0.001, 0.001), osg::Vec2(100.0, 100.0), osg::Vec4(1, 1, 1, 1)});
+    std::cout << "grid of 0.001 spacing over 200 x 200" << std::endl;
+    measure("get(GridVec_t)", [&]() { return d3::get(grids); });
+    measure("through LineVec_t", [&]()
+            {
+                d3::LineVec_t lines;
+                for ( const d3::Grid& grid : grids )
+                {
+                    for ( double xx(-grid.halfSpan.x()) ; xx<=grid.halfSpan.x() ; xx+=grid.spacing.x() )
+                        lines.push_back(d3::Line{osg::Vec3d(xx, -grid.halfSpan.y(), 0.0),
+                                                 osg::Vec3d(xx,  grid.halfSpan.y(), 0.0), grid.color});
+                    for ( double yy(-grid.halfSpan.y()) ; yy<=grid.halfSpan.y() ; yy+=grid.spacing.y() )
+                        lines.push_back(d3::Line{osg::Vec3d(-grid.halfSpan.x(), yy, 0.0),
+                                                 osg::Vec3d( grid.halfSpan.x(), yy, 0.0), grid.color});
+                }
+                return d3::get(lines);
+            });
+
+    // a long trajectory of poses
+    d3::TriadVec_t triads;
+    for ( int ii(0) ; ii<200000 ; ++ii )
+        triads.push_back(d3::Triad{osg::Matrix::rotate(1e-3*ii, osg::Vec3d(0, 0, 1)) *
+                                   osg::Matrix::translate(1e-3*ii, 0.0, 0.0)});
+    std::cout << triads.size() << " triads" << std::endl;
+    measure("get(TriadVec_t)", [&]() { return d3::get(triads); });
+    measure("through LineVec_t", [&]()
+            {
+                d3::LineVec_t lines;
+                for ( const d3::Triad& triad : triads )
+                {
+                    const osg::Vec3d origin( triad.pose.getTrans() );
+                    lines.push_back(d3::Line{origin, osg::Vec3d(1, 0, 0)*triad.pose, osg::Vec4(1, 0, 0, 1)});
+                    lines.push_back(d3::Line{origin, osg::Vec3d(0, 1, 0)*triad.pose, osg::Vec4(0, 1, 0, 1)});
+                    lines.push_back(d3::Line{origin, osg::Vec3d(0, 0, 1)*triad.pose, osg::Vec4(0, 0, 1, 1)});
+                }
+                return d3::get(lines);
+            });
+
+    return EXIT_SUCCESS;
+}
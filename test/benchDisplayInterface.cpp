@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchDisplayInterface.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Measure what the display costs the process it is embedded in
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Grids.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The cpu used by the whole process while sleeping for a while
+/// @param   period How long to measure for
+/// @return  double The cpu used as a percentage of one core
+/////////////////////////////////////////////////////////////////
+double idleCpu(const std::chrono::milliseconds& period)
+{
+    auto cpuSeconds = []() -> double
+        {
+            rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+            return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                1e-6*(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+        };
+
+    const double before( cpuSeconds() );
+    std::this_thread::sleep_for(period);
+    const double after( cpuSeconds() );
+
+    return 100.0 * (after - before) / std::chrono::duration<double>(period).count();
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    // bring the display up and let it settle
+    d3::di().add( "ground", d3::ground() );
+    d3::di().flush().wait();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    // what the display costs while nothing is changing
+    std::cout << "idle cpu (continuous): " << idleCpu(std::chrono::seconds(5)) << " %" << std::endl;
+
+    d3::di().setOnDemandRendering(true);
+    d3::di().flush().wait();
+    std::cout << "idle cpu (on demand):  " << idleCpu(std::chrono::seconds(5)) << " %" << std::endl;
+
+    // how long an add takes to be applied by the display thread, with the
+    // producer pausing between adds the way a real algorithm loop would
+    static const size_t numAdds(200);
+    std::vector<double> latency;
+    latency.reserve(numAdds);
+    for ( size_t ii(0) ; ii<numAdds ; ++ii )
+    {
+        const auto start( std::chrono::steady_clock::now() );
+        d3::di().add( "latency", d3::get(d3::Point{osg::Vec3d(0.01*ii, 0.0, 1.0), d3::white()}) );
+        d3::di().flush().wait();
+        latency.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(7));
+    }
+
+    std::sort(latency.begin(), latency.end());
+    std::cout << "add latency (ms): "
+              << "median " << latency[latency.size()/2] << ", "
+              << "p99 " << latency[(latency.size()*99)/100] << ", "
+              << "max " << latency.back() << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchHashed.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Measure re-adding the same static content every cycle
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Hash.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    static const size_t numPoints(200000);
+    static const size_t numCycles(200);
+
+    // a static "map" re-added every cycle
+    d3::PointVec_t map;
+    map.reserve(numPoints);
+    for ( size_t ii(0) ; ii<numPoints ; ++ii )
+        map.push_back(d3::Point{osg::Vec3d(std::cos(0.001*ii)*ii*1e-4, std::sin(0.001*ii)*ii*1e-4, 0), d3::white()});
+
+    // how fast the hash is on its own
+    {
+        const auto start( std::chrono::steady_clock::now() );
+        uint64_t sum(0);
+        for ( size_t ii(0) ; ii<numCycles ; ++ii )
+            sum += d3::hash(map, ii);
+        const double seconds( std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() );
+        std::cout << "hash:      " << (numCycles*map.size()*sizeof(d3::Point))/seconds/1e9 << " GB/s"
+                  << " (" << (sum & 1) << ")" << std::endl;
+    }
+
+    // building and swapping it every cycle
+    {
+        const auto start( std::chrono::steady_clock::now() );
+        for ( size_t ii(0) ; ii<numCycles ; ++ii )
+            d3::di().add( "map", d3::get(map) );
+        d3::di().flush().wait();
+        std::cout << "add:       " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                  << " s for " << numCycles << " cycles" << std::endl;
+    }
+
+    // the same through the hash - only the first cycle builds anything
+    {
+        const auto start( std::chrono::steady_clock::now() );
+        for ( size_t ii(0) ; ii<numCycles ; ++ii )
+            d3::di().addHashed( "map", map );
+        d3::di().flush().wait();
+        std::cout << "addHashed: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                  << " s for " << numCycles << " cycles" << std::endl;
+    }
+
+    // and a second name showing the same map shares its geometry
+    d3::di().addHashed( "map copy", map );
+    d3::di().flush().wait();
+
+    return EXIT_SUCCESS;
+}
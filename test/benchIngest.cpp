@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchIngest.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Measure the ways a float scan can be turned into a cloud
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayObjects/Points.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A point as a scanner hands it over
+/////////////////////////////////////////////////////////////////
+struct ScanPoint
+{
+    /// The location
+    float   xyz[3];
+
+    /// The intensity
+    float   intensity;
+
+    /// The color
+    uint8_t rgba[4];
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Time a way of building the cloud
+/////////////////////////////////////////////////////////////////
+void time(const std::string& name,
+          const std::function<osg::ref_ptr<osg::Node>()>& build)
+{
+    const auto start( std::chrono::steady_clock::now() );
+    osg::ref_ptr<osg::Node> node( build() );
+    std::cout << name << ": "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+              << " s" << (node ? "" : " (failed)") << std::endl;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    static const size_t numPoints(5000000);
+
+    std::vector<ScanPoint> scan(numPoints);
+    for ( size_t ii(0) ; ii<numPoints ; ++ii )
+    {
+        const float tt( 1e-4f*ii );
+        scan[ii] = ScanPoint{{std::cos(tt)*tt, std::sin(tt)*tt, 0.01f*tt}, 1.0f,
+                             {static_cast<uint8_t>(ii), 128, 255, 255}};
+    }
+
+    // through a PointVec_t
+    time("PointVec_t", [&]()
+         {
+             d3::PointVec_t points;
+             points.reserve(scan.size());
+             for ( const ScanPoint& pt : scan )
+                 points.push_back(d3::Point{osg::Vec3d(pt.xyz[0], pt.xyz[1], pt.xyz[2]),
+                                            osg::Vec4(pt.rgba[0], pt.rgba[1], pt.rgba[2], pt.rgba[3])/255.0f});
+             return d3::get(points);
+         });
+
+    // straight from the interleaved scan
+    time("strided", [&]()
+         {
+             return d3::get(scan.front().xyz, sizeof(ScanPoint), scan.front().rgba, sizeof(ScanPoint), scan.size());
+         });
+
+    // filled in place and handed over
+    time("adopted", [&]()
+         {
+             std::vector<osg::Vec3f> locations;
+             std::vector<osg::Vec4ub> colors;
+             locations.reserve(scan.size());
+             colors.reserve(scan.size());
+             for ( const ScanPoint& pt : scan )
+             {
+                 locations.push_back(osg::Vec3f(pt.xyz[0], pt.xyz[1], pt.xyz[2]));
+                 colors.push_back(osg::Vec4ub(pt.rgba[0], pt.rgba[1], pt.rgba[2], pt.rgba[3]));
+             }
+             return d3::get(std::move(locations), std::move(colors));
+         });
+
+    return EXIT_SUCCESS;
+}
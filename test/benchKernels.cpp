@@ -0,0 +1,174 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchKernels.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Measure the builder kernels against a plain loop
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Kernels.h>
+#include <DDDisplayObjects/Lines.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <osg/Array>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Time something, best of a few runs
+/// @return  The seconds it took
+/////////////////////////////////////////////////////////////////
+double time(const std::function<void()>& run)
+{
+    double best(0.0);
+    for ( int ii(0) ; ii<3 ; ++ii )
+    {
+        const auto start( std::chrono::steady_clock::now() );
+        run();
+        const double seconds( std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() );
+        if ( (0 == ii) || (seconds < best) ) best = seconds;
+    }
+    return best;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Print a comparison
+/////////////////////////////////////////////////////////////////
+void report(const std::string& name,
+            const double& loop,
+            const double& kernel)
+{
+    std::cout << "  " << std::setw(10) << std::left << name << std::right
+              << " loop " << std::setw(10) << loop*1e3 << " ms"
+              << "   kernel " << std::setw(10) << kernel*1e3 << " ms"
+              << "   x" << loop/kernel << std::endl;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Check the kernels skip a NaN location in a bound
+/// @return  boolean The kernels bound only the finite locations
+/////////////////////////////////////////////////////////////////
+bool checkNaN()
+{
+    const double nan( std::numeric_limits<double>::quiet_NaN() );
+    const double xyz[] = { -5.0, -5.0, -5.0,
+                           nan, nan, nan,
+                           1.0, 1.0, 1.0,
+                           2.0, 2.0, 2.0 };
+    const size_t count( sizeof(xyz)/sizeof(xyz[0])/3 );
+    const osg::BoundingBox expected(-5.0f, -5.0f, -5.0f, 2.0f, 2.0f, 2.0f);
+
+    float narrow[3*count];
+    osg::BoundingBox narrowed;
+    d3::narrowToFloats(xyz, 3*sizeof(double), count, narrow, 3*sizeof(float), narrowed);
+
+    osg::BoundingBox grown;
+    d3::growBound(narrow, 3*sizeof(float), count, grown);
+
+    bool ok(true);
+    if ( narrowed._min != expected._min || narrowed._max != expected._max )
+    {
+        std::cerr << "ERROR - narrowToFloats lost the bound before a NaN" << std::endl;
+        ok = false;
+    }
+    if ( grown._min != expected._min || grown._max != expected._max )
+    {
+        std::cerr << "ERROR - growBound lost the bound before a NaN" << std::endl;
+        ok = false;
+    }
+    return ok;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    if ( not checkNaN() ) return EXIT_FAILURE;
+
+    for ( const size_t count : {size_t(100000), size_t(1000000), size_t(10000000)} )
+    {
+        d3::PointVec_t points(count);
+        for ( size_t ii(0) ; ii<count ; ++ii )
+        {
+            const double tt( 1e-5*ii );
+            points[ii] = d3::Point{osg::Vec3d(std::cos(tt)*tt, std::sin(tt)*tt, 0.01*tt),
+                                   osg::Vec4(std::fmod(tt, 1.0), 0.5f, 1.0f, 1.0f)};
+        }
+        std::cout << count << " elements" << std::endl;
+
+        // narrowing the locations and bounding them
+        osg::ref_ptr<osg::Vec3Array> verts( new osg::Vec3Array(count) );
+        const double narrowLoop( time([&]()
+            {
+                osg::BoundingBox bound;
+                for ( size_t ii(0) ; ii<count ; ++ii )
+                {
+                    (*verts)[ii] = points[ii].location;
+                    bound.expandBy((*verts)[ii]);
+                }
+            }) );
+        const double narrowKernel( time([&]()
+            {
+                osg::BoundingBox bound;
+                d3::narrowToFloats(points.front().location.ptr(), sizeof(d3::Point), count,
+                                   verts->front().ptr(), sizeof(osg::Vec3f), bound);
+            }) );
+        report("narrow", narrowLoop, narrowKernel);
+
+        // packing the colors
+        osg::ref_ptr<osg::Vec4ubArray> colors( new osg::Vec4ubArray(count) );
+        const double packLoop( time([&]()
+            {
+                for ( size_t ii(0) ; ii<count ; ++ii )
+                    (*colors)[ii] = d3::toBytes(points[ii].color);
+            }) );
+        const double packKernel( time([&]()
+            {
+                d3::packColors(points.front().color.ptr(), sizeof(d3::Point), count,
+                               colors->front().ptr(), sizeof(osg::Vec4ub));
+            }) );
+        report("pack", packLoop, packKernel);
+
+        // bounding floats
+        const double boundLoop( time([&]()
+            {
+                osg::BoundingBox bound;
+                for ( const osg::Vec3f& vert : *verts ) bound.expandBy(vert);
+            }) );
+        const double boundKernel( time([&]()
+            {
+                osg::BoundingBox bound;
+                d3::growBound(verts->front().ptr(), sizeof(osg::Vec3f), count, bound);
+            }) );
+        report("bound", boundLoop, boundKernel);
+
+        // the builders end to end, bound included
+        d3::LineVec_t lines(count/2);
+        for ( size_t ii(0) ; ii<lines.size() ; ++ii )
+            lines[ii] = d3::Line{points[2*ii].location, points[2*ii + 1].location, points[2*ii].color};
+        const double buildPoints( time([&]()
+            {
+                osg::ref_ptr<osg::Node> node( d3::get(points) );
+                if ( node ) node->getBound();
+            }) );
+        const double buildLines( time([&]()
+            {
+                osg::ref_ptr<osg::Node> node( d3::get(lines) );
+                if ( node ) node->getBound();
+            }) );
+        std::cout << "  get(PointVec_t) " << buildPoints*1e3 << " ms, get(LineVec_t) "
+                  << buildLines*1e3 << " ms" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchTreeView.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Measure filling the tree view with many names under one parent
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Add (or replace) a range of names and wait for the display
+/// @param   first The first index
+/// @param   last One past the last index
+/// @param   node The node to add under every name
+/// @return  double The microseconds per name
+/////////////////////////////////////////////////////////////////
+double fill(const size_t& first,
+            const size_t& last,
+            const osg::ref_ptr<osg::Node>& node)
+{
+    static const size_t batchSize(1000);
+
+    const auto start( std::chrono::steady_clock::now() );
+    for ( size_t ii(first) ; ii<last ; ii+=batchSize )
+    {
+        auto batch( d3::di().beginBatch() );
+        for ( size_t jj(ii) ; (jj<ii+batchSize) && (jj<last) ; ++jj )
+            batch.add( "tracks::track " + std::to_string(jj), node );
+    }
+    d3::di().flush().wait();
+    const auto stop( std::chrono::steady_clock::now() );
+
+    return std::chrono::duration<double, std::micro>(stop - start).count() / (last - first);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    static const size_t numNames(100000);
+    static const size_t step(10000);
+
+    const osg::ref_ptr<osg::Node> node( d3::get(d3::Point{osg::Vec3d(0.0, 0.0, 0.0), d3::white()}) );
+
+    // bring the display up first so that isn't part of the first step
+    d3::di().add( "tracks", new osg::Group() );
+    d3::di().flush().wait();
+
+    // with a hashed lookup the cost per add stays flat as the parent fills up
+    std::cout << "names     add (us/name)" << std::endl;
+    for ( size_t ii(0) ; ii<numNames ; ii+=step )
+        std::cout << ii + step << "    " << fill(ii, ii + step, node) << std::endl;
+
+    std::cout << "replace all " << numNames << ": " << fill(0, numNames, node) << " us/name" << std::endl;
+
+    // and again through handles, which skip the name parsing and the lookups
+    std::vector<d3::Handle> handles;
+    handles.reserve(numNames);
+    for ( size_t ii(0) ; ii<numNames ; ++ii )
+        handles.push_back(d3::di().handle("tracks::track " + std::to_string(ii)));
+
+    for ( int pass(0) ; pass<2 ; ++pass )
+    {
+        const auto start( std::chrono::steady_clock::now() );
+        for ( const d3::Handle& handle : handles )
+            d3::di().replace( handle, node );
+        d3::di().flush().wait();
+        const auto stop( std::chrono::steady_clock::now() );
+
+        // the first pass resolves each handle's tree entry
+        std::cout << "replace all " << numNames << " by handle" << (0 == pass ? " (first)" : "") << ": "
+                  << std::chrono::duration<double, std::micro>(stop - start).count() / numNames
+                  << " us/name" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,197 @@
+/////////////////////////////////////////////////////////////////
+/// @file      benchWake.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Compare the old sleep polling display loop with the posted wake
+///            it was replaced by
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A display thread with nothing but the way it is woken up
+///
+/// The polling loop is the one the display thread ran before it moved into the
+/// qt event loop: drain, then sleep 10 ms. The waking loop sleeps until the
+/// first command after a drain posts a wake, like CommandPump. Neither draws,
+/// so this is only the cost of the loop itself - benchDisplayInterface
+/// measures the real display.
+/////////////////////////////////////////////////////////////////
+class Loop
+{
+  public:
+
+    /// @brief   Constructor - starts the thread
+    /// @param   poll Poll with a sleep (the old loop) rather than wait for a
+    ///          wake
+    explicit Loop(const bool& poll) :
+        m_poll(poll),
+        m_running(true),
+        m_commandMutex(),
+        m_commands(),
+        m_wakePending(false),
+        m_wakeMutex(),
+        m_wake(),
+        m_posted(false),
+        m_thread()
+    {
+        m_thread = std::thread(&Loop::run, this);
+    };
+
+    /// @brief   Destructor - stops the thread
+    ~Loop()
+    {
+        m_running = false;
+        post();
+        m_thread.join();
+    };
+
+    /// @brief   Hand a command to the thread
+    void add(std::function<void()>&& command)
+    {
+        {
+            std::lock_guard<std::mutex> l_lock(m_commandMutex);
+            m_commands.push_back(std::move(command));
+        }
+        if ( not m_poll && not m_wakePending.exchange(true) ) post();
+    };
+
+  private:
+
+    /// @brief   Wake the thread
+    void post()
+    {
+        {
+            std::lock_guard<std::mutex> l_lock(m_wakeMutex);
+            m_posted = true;
+        }
+        m_wake.notify_one();
+    };
+
+    /// @brief   Run the queued commands
+    void drain()
+    {
+        std::deque<std::function<void()>> commands;
+        {
+            std::lock_guard<std::mutex> l_lock(m_commandMutex);
+            commands.swap(m_commands);
+        }
+        for ( const auto& command : commands ) command();
+    };
+
+    /// @brief   The thread
+    void run()
+    {
+        while ( m_running )
+        {
+            if ( m_poll )
+            {
+                drain();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+
+            {
+                std::unique_lock<std::mutex> l_lock(m_wakeMutex);
+                m_wake.wait(l_lock, [this]() { return m_posted; });
+                m_posted = false;
+            }
+            m_wakePending = false;
+            drain();
+        }
+    };
+
+    /// Poll rather than wait
+    const bool                        m_poll;
+
+    /// Cleared to stop
+    std::atomic<bool>                 m_running;
+
+    /// Protects the commands
+    std::mutex                        m_commandMutex;
+
+    /// The queued commands
+    std::deque<std::function<void()>> m_commands;
+
+    /// Set while a wake is on its way
+    std::atomic<bool>                 m_wakePending;
+
+    /// Pairs with m_wake
+    std::mutex                        m_wakeMutex;
+
+    /// The wake
+    std::condition_variable           m_wake;
+
+    /// Set by a wake
+    bool                              m_posted;
+
+    /// The display thread
+    std::thread                       m_thread;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The cpu used by the whole process
+/////////////////////////////////////////////////////////////////
+double cpuSeconds()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+        1e-6*(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    for ( const bool poll : {true, false} )
+    {
+        Loop loop(poll);
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        // the same two numbers as benchDisplayInterface
+        const double before( cpuSeconds() );
+        std::this_thread::sleep_for(std::chrono::seconds(5));
+        const double idle( 100.0*(cpuSeconds() - before)/5.0 );
+
+        static const size_t numAdds(200);
+        std::vector<double> latency;
+        latency.reserve(numAdds);
+        for ( size_t ii(0) ; ii<numAdds ; ++ii )
+        {
+            const auto start( std::chrono::steady_clock::now() );
+            std::shared_ptr<std::promise<void>> done( std::make_shared<std::promise<void>>() );
+            loop.add([done]() { done->set_value(); });
+            done->get_future().wait();
+            latency.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(7));
+        }
+
+        std::sort(latency.begin(), latency.end());
+        std::cout << (poll ? "sleep polling: " : "posted wake:   ")
+                  << "idle cpu " << idle << " %, add latency (ms) "
+                  << "median " << latency[latency.size()/2] << ", "
+                  << "p99 " << latency[(latency.size()*99)/100] << ", "
+                  << "max " << latency.back() << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
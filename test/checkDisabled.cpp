@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////
+/// @file      checkDisabled.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     A hot loop with debug display calls, both wrapped in D3() and
+///            plain, built by the checkDisabled target with D3_DISABLE and
+///            against a baseline without any d3 at all - the two must come out
+///            the same
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#ifdef   D3_CHECK_BASELINE
+
+#include <osg/Vec3d>
+#define D3(...)
+
+/// The baseline has no d3 at all, so the plain calls go too
+#define PLAIN(...)
+
+#else    // D3_CHECK_BASELINE
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Lines.h>
+#include <DDDisplayObjects/Points.h>
+
+/// Calls written as they would be without D3() - with D3_DISABLE only the
+/// stubs can take these out
+#define PLAIN(...) __VA_ARGS__
+
+#endif   // D3_CHECK_BASELINE
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The loop under test
+/// @param   cloud Some points to chew on
+/// @return  double Something that depends on every point, so the loop itself
+///          isn't thrown away
+/////////////////////////////////////////////////////////////////
+double hotLoop(const std::vector<osg::Vec3d>& cloud)
+{
+    double total(0.0);
+
+    PLAIN( d3::PointVec_t points; );
+    PLAIN( d3::LineVec_t lines; );
+    D3( points.reserve(cloud.size()); );
+    for ( size_t ii(0) ; ii<cloud.size() ; ++ii )
+    {
+        total += cloud[ii].length2();
+
+        D3( points.push_back(d3::Point{cloud[ii], d3::nextColor()}); );
+        D3( if ( 0 < ii ) lines.push_back(d3::Line{cloud[ii-1], cloud[ii], d3::white()}); );
+
+        PLAIN( d3::di().add("check::point", d3::get(d3::Point{cloud[ii], d3::nextColor()}), false); );
+        PLAIN( if ( 0 < ii ) d3::di().add("check::step", d3::get(d3::Line{cloud[ii-1], cloud[ii], d3::red()})); );
+    }
+
+    PLAIN( d3::di().add("check::cloud", d3::get(points, 2.0f)); );
+    PLAIN( d3::di().add("check::lines", d3::get(lines)); );
+    PLAIN( d3::di().requestRedraw(); );
+    D3( d3::di().flush().wait(); );
+
+    return total;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<osg::Vec3d> cloud;
+    for ( int ii(0) ; ii<1000 ; ++ii )
+        cloud.push_back(osg::Vec3d(0.001*ii, 0.002*ii, 0.003*ii));
+
+    return (hotLoop(cloud) > 0.0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -44,7 +44,9 @@ int main()
     std::thread thrd
         ([&]()
          {
-             while ( d3::di().running() )
+             // flash at about 2Hz until the window closes (and stop the
+             // moment it does)
+             while ( not d3::di().waitForClose(std::chrono::milliseconds(500)) )
              {
                  // we are messing directly with things in the render thread -
                  // make sure we lock the display interface
@@ -53,9 +55,6 @@ int main()
                      hud.show(not hud.isShown());
                      d3::di().unlock();
                  }
-
-                 // flash at about 2Hz
-                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
              }
          });
 
@@ -0,0 +1,119 @@
+/////////////////////////////////////////////////////////////////
+/// @file      testAsyncDrop.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Check that an addAsync() thrown away by the queue still answers
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Grids.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <osg/Group>
+
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+
+/// @brief   Data whose build throws something that isn't an exception
+struct Thrower
+{
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The get() of a Thrower (found by the pool like any d3::get())
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> get(const Thrower&)
+{
+    throw 42;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A future's value, or an error if it broke
+/// @return  int 1 for true, 0 for false, -1 if it broke
+/////////////////////////////////////////////////////////////////
+int answer(std::future<bool>& future)
+{
+    try
+    {
+        return future.get() ? 1 : 0;
+    }
+    catch ( const std::future_error& e )
+    {
+        std::cerr << "ERROR - the future broke: " << e.what() << std::endl;
+        return -1;
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    static const std::chrono::seconds patience(10);
+
+    d3::di().add( "ground", d3::ground() );
+    d3::di().flush().wait();
+    d3::di().setQueuePolicy(d3::QueuePolicy::DROP_OLDEST);
+
+    // holding the display keeps the queue from draining
+    d3::di().lock();
+
+    // the built node is queued behind the lock ...
+    std::future<bool> built( d3::di().addAsync("async::cloud",
+                                               d3::PointVec_t(1000, d3::Point{osg::Vec3d(), d3::white()})) );
+
+    // ... and the flood pushes it out the front
+    size_t flood(0);
+    const auto start( std::chrono::steady_clock::now() );
+    while ( (std::future_status::ready != built.wait_for(std::chrono::seconds(0))) &&
+            (std::chrono::steady_clock::now() - start < patience) )
+    {
+        d3::di().add( "async::flood", new osg::Group() );
+        ++flood;
+    }
+    d3::di().unlock();
+
+    if ( std::future_status::ready != built.wait_for(std::chrono::seconds(0)) )
+    {
+        std::cerr << "ERROR - the evicted addAsync() never answered after "
+                  << flood << " adds" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const int evicted( answer(built) );
+    std::cout << "evicted after " << flood << " adds (" << d3::di().getDroppedOldest()
+              << " dropped): " << evicted << std::endl;
+    if ( 0 != evicted )
+    {
+        std::cerr << "ERROR - the evicted addAsync() should be false" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // a build that throws something other than an exception is false too,
+    // and doesn't take the process down with it
+    d3::di().setQueuePolicy(d3::QueuePolicy::BLOCK);
+    std::future<bool> thrown( d3::di().addAsync("async::thrown", Thrower()) );
+    if ( 0 != answer(thrown) )
+    {
+        std::cerr << "ERROR - the addAsync() that threw should be false" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // and an add that makes it is true
+    std::future<bool> shown( d3::di().addAsync("async::shown",
+                                               d3::PointVec_t(1000, d3::Point{osg::Vec3d(), d3::green()})) );
+    if ( 1 != answer(shown) )
+    {
+        std::cerr << "ERROR - the addAsync() after the flood should be true" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+/////////////////////////////////////////////////////////////////
+/// @file      testAsyncOrder.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Check that a slow addAsync() never replaces a newer add of the
+///            same name
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Grids.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/// @brief   Data whose build takes a while
+struct Slow
+{
+    /// How long the build takes
+    std::chrono::milliseconds delay;
+
+    /// What the build gives
+    osg::ref_ptr<osg::Node>   node;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The get() of a Slow (found by the pool like any d3::get())
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> get(const Slow& slow)
+{
+    std::this_thread::sleep_for(slow.delay);
+    return slow.node;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A point of some color
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> point(const osg::Vec4& color)
+{
+    return d3::get(d3::Point{osg::Vec3d(0.0, 0.0, 1.0), color});
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Check which of two nodes the display has
+/// @param   newer The node that should be shown
+/// @param   older The node that should not
+/// @param   what What the check is about
+/// @return  boolean True if only the newer node is in the scene
+/////////////////////////////////////////////////////////////////
+bool check(const osg::ref_ptr<osg::Node>& newer,
+           const osg::ref_ptr<osg::Node>& older,
+           const std::string& what)
+{
+    d3::di().flush().wait();
+    d3::di().lock();
+    const bool newerShown( not newer->getParents().empty() );
+    const bool olderShown( not older->getParents().empty() );
+    d3::di().unlock();
+
+    if ( newerShown && not olderShown ) return true;
+
+    std::cerr << "ERROR - " << what << ": the newer node is "
+              << (newerShown ? "" : "not ") << "shown, the older one is "
+              << (olderShown ? "" : "not ") << "shown" << std::endl;
+    return false;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    static const std::chrono::milliseconds slow(500);
+    static const std::chrono::milliseconds fast(0);
+
+    d3::di().add( "ground", d3::ground() );
+    d3::di().flush().wait();
+
+    bool ok(true);
+
+    // the first build finishes last
+    const osg::ref_ptr<osg::Node> first( point(d3::red()) );
+    const osg::ref_ptr<osg::Node> second( point(d3::green()) );
+    std::future<bool> firstDone( d3::di().addAsync("order::async", Slow{slow, first}) );
+    std::future<bool> secondDone( d3::di().addAsync("order::async", Slow{fast, second}) );
+    if ( not secondDone.get() )
+    {
+        std::cerr << "ERROR - the newer addAsync() should be shown" << std::endl;
+        ok = false;
+    }
+    if ( firstDone.get() )
+    {
+        std::cerr << "ERROR - the older addAsync() should be superseded" << std::endl;
+        ok = false;
+    }
+    ok &= check(second, first, "two addAsync()");
+
+    // a plain add after a build that is still going
+    const osg::ref_ptr<osg::Node> built( point(d3::red()) );
+    const osg::ref_ptr<osg::Node> added( point(d3::blue()) );
+    std::future<bool> builtDone( d3::di().addAsync("order::add", Slow{slow, built}) );
+    d3::di().add( "order::add", added );
+    if ( builtDone.get() )
+    {
+        std::cerr << "ERROR - the addAsync() before an add() should be superseded" << std::endl;
+        ok = false;
+    }
+    ok &= check(added, built, "addAsync() then add()");
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -100,7 +100,8 @@ int main(int argc, char* argv[])
     for ( double xx(-1.0) ; xx<=1.0 ; xx+=0.1 )
         for ( double yy(-1.0) ; yy<=1.0 ; yy+=0.1 )
             cpts.push_back(d3::Point{{xx,yy,3.0}, d3::nextColor()});
-    d3::di().add( "color cloud", d3::get(cpts) );
+    // built on the display's worker pool - this thread only pays for the move
+    std::future<bool> colorCloud( d3::di().addAsync( "color cloud", std::move(cpts), 3.0f ) );
 
     d3::di().add( 'j',
                   [&](const osgGA::GUIEventAdapter& ev)->bool
@@ -138,6 +139,20 @@ int main(int argc, char* argv[])
                    },
                    "Typing \'k\' is cool" );
 
+    bool appendersVisible(true);
+    d3::di().add( 'v',
+                  [&](const osgGA::GUIEventAdapter& ev)->bool
+                   {
+                       if (osgGA::GUIEventAdapter::KEYDOWN == ev.getEventType())
+                       {
+                           appendersVisible = not appendersVisible;
+                           d3::di().setVisible( "par::*appender", appendersVisible );
+                           return true;
+                       }
+                       return false;
+                   },
+                   "Typing \'v\' shows and hides all the appenders" );
+
     d3::di().add( osgGA::GUIEventAdapter::LEFT_MOUSE_BUTTON,
                   [&](const osgGA::GUIEventAdapter& event)->bool
                   {
@@ -175,6 +190,13 @@ int main(int argc, char* argv[])
     d3::di().add( "par::appender", d3::get(d3::Point{osg::Vec3d(5,0,0), d3::white()}), replace);
     d3::di().add( "par::appender", d3::get(d3::Point{osg::Vec3d(6,0,0), d3::white()}), replace);
 
+    // the same through handles - the name is only looked up by the first add
+    static constexpr d3::Path handlePath("par::handle::appender");
+    const d3::Handle handle( d3::di().handle(handlePath) );
+    for ( int ii(0) ; ii<3 ; ++ii )
+        d3::di().add( handle, d3::get(d3::Point{osg::Vec3d(ii,1,0), d3::white()}), replace );
+    d3::di().replace( d3::di().handle("par::handle::replacer"), d3::get(d3::Point{osg::Vec3d(0,2,0), d3::white()}) );
+
     d3::HeadsUpDisplay hud0;//(0.5, 0.1,  d3::HeadsUpDisplay::Position::BOTTOM);
     d3::HeadsUpDisplay hud1(1.0, 0.04, d3::HeadsUpDisplay::Position::TOP);
     d3::HeadsUpDisplay hud2(0.04, 1.0, d3::HeadsUpDisplay::Position::LEFT);
@@ -218,9 +240,19 @@ int main(int argc, char* argv[])
     d3::di().add( "tracked point", pointXform );
     d3::di().track(point);
 
+    // the same kind of moving point, but double buffered - no locking and no
+    // lost updates
+    osg::ref_ptr<osg::MatrixTransform> bufferedXform(new osg::MatrixTransform());
+    bufferedXform->addChild(d3::get(d3::Point{osg::Vec3d(0,0,1), d3::nextColor()}));
+    auto bufferedPoint( d3::di().addBuffered("buffered point", bufferedXform) );
+
     double xOffset(0.0);
     double direction = 0.01;
 
+    // keep the last few hundred positions of a replaced point to scrub back
+    // through on the timeline
+    d3::di().setHistory("history", 300);
+
     uint count(0);
     while ( d3::di().running() )
     {
@@ -240,6 +272,26 @@ int main(int argc, char* argv[])
             d3::di().unlock();
         }
 
+        if ( bufferedPoint )
+        {
+            bufferedPoint->back()->setMatrix(osg::Matrix::translate(-xOffset, 0, 0));
+            bufferedPoint->publish();
+        }
+
+        // a fading trail - each sample takes itself out after half a second
+        d3::di().add( "trail", d3::get(d3::Point{osg::Vec3d(xOffset, -1, 0), d3::white()}),
+                      d3::TimeToLive::seconds(0.5), false );
+
+        // and the last hundred positions, however long this runs
+        d3::di().add( "window", d3::get(d3::Point{osg::Vec3d(xOffset, -2, 0), d3::white()}),
+                      d3::Append::Window{100} );
+
+        // static content re-added every cycle is only built the first time
+        d3::di().addHashed( "marker", d3::Grid{osg::Vec2(0.1, 0.1), osg::Vec2(0.5, 0.5), d3::white()} );
+
+        // the current position only (the timeline shows the ones before)
+        d3::di().add( "history", d3::get(d3::Point{osg::Vec3d(xOffset, -3, 0), d3::white()}) );
+
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
@@ -259,6 +311,9 @@ int main(int argc, char* argv[])
     }
     d3::di().unlock();
 
+    if ( not colorCloud.get() )
+        std::cerr << "Could not add the color cloud" << std::endl;
+
     // wait for close
     d3::di().blockForClose();
 
@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////////
+/// @file      testHistory.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Check the versions kept by the history, without a display
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/History.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A new cloud of points
+/// @param   numPoints The number of points
+/// @param   offset Where along x they start (the same offset is the same
+///          content)
+/////////////////////////////////////////////////////////////////
+osg::ref_ptr<osg::Node> cloud(const size_t& numPoints,
+                              const double& offset)
+{
+    d3::PointVec_t points;
+    points.reserve(numPoints);
+    for ( size_t ii(0) ; ii<numPoints ; ++ii )
+        points.push_back(d3::Point{osg::Vec3d(offset + 0.01*ii, 0.0, 0.0), d3::white()});
+    return d3::get(points);
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Report a failed check
+/// @return  boolean The check
+/////////////////////////////////////////////////////////////////
+bool check(const bool& ok,
+           const std::string& what)
+{
+    if ( not ok ) std::cerr << "ERROR - " << what << std::endl;
+    return ok;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    const d3::History::Time_t start( std::chrono::steady_clock::now() );
+    auto at = [&start](const double& seconds)
+        {
+            return start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+        };
+
+    bool ok(true);
+
+    d3::History history;
+    history.track("scan", 3);
+
+    // a name that isn't tracked keeps nothing
+    const osg::ref_ptr<osg::Node> other( cloud(100, 0.0) );
+    ok &= check(other == history.record("other", other, at(0.0)), "an untracked name should show its node");
+    ok &= check(0 == history.getBytes(), "an untracked name should keep nothing");
+
+    // the same content twice shares the first node
+    const osg::ref_ptr<osg::Node> first( cloud(1000, 0.0) );
+    const osg::ref_ptr<osg::Node> same( cloud(1000, 0.0) );
+    ok &= check(first == history.record("scan::cloud", first, at(0.0)), "a new version should be shown");
+    const size_t oneVersion( history.getBytes() );
+    ok &= check(0 < oneVersion, "a version should count its bytes");
+    ok &= check(first == history.record("scan::cloud", same, at(1.0)), "equal content should share the kept node");
+    ok &= check(oneVersion == history.getBytes(), "a shared version should cost nothing");
+    ok &= check(history.keeps(first.get()) && not history.keeps(same.get()), "only the shared node should be kept");
+
+    const osg::ref_ptr<osg::Node> second( cloud(1000, 1.0) );
+    const osg::ref_ptr<osg::Node> third( cloud(1000, 2.0) );
+    history.record("scan::cloud", second, at(2.0));
+    history.record("scan::cloud", third, at(3.0));
+
+    // the lookups find the latest version at or before a time
+    ok &= check(not history.at("scan::cloud", at(-1.0)), "nothing should be kept from before the first version");
+    ok &= check(first == history.at("scan::cloud", at(1.5)), "between versions should give the earlier one");
+    ok &= check(second == history.at("scan::cloud", at(2.0)), "a version's own time should give that version");
+    ok &= check(third == history.latest("scan::cloud"), "the latest should be the last recorded");
+
+    // a fourth version pushes out the first
+    const osg::ref_ptr<osg::Node> fourth( cloud(1000, 3.0) );
+    history.record("scan::cloud", fourth, at(4.0));
+    ok &= check(not history.at("scan::cloud", at(1.5)), "the oldest version should go past the limit");
+    ok &= check(not history.keeps(first.get()), "the oldest node should no longer be kept");
+
+    // forgetting a name drops the names under it too
+    history.record("scan::other", cloud(1000, 9.0), at(5.0));
+    history.forget("scan");
+    ok &= check(history.names().empty() && (0 == history.getBytes()), "forget should drop everything under the name");
+
+    // over budget, the least recently recorded or shown goes first
+    d3::History budget;
+    budget.track("", 10);
+    const osg::ref_ptr<osg::Node> older( cloud(1000, 0.0) );
+    const osg::ref_ptr<osg::Node> newer( cloud(1000, 1.0) );
+    budget.record("older", older, at(0.0));
+    budget.record("newer", newer, at(1.0));
+    ok &= check(older == budget.at("older", at(1.0)), "the older name should have its version");
+    const size_t limit( budget.getBytes() - 1 );
+    budget.setBudget(limit);
+    ok &= check(budget.keeps(older.get()) && not budget.keeps(newer.get()),
+                "the least recently used version should go over budget");
+    ok &= check(budget.getBytes() <= limit, "the bytes should be under budget");
+
+    if ( not ok ) return EXIT_FAILURE;
+
+    std::cout << "history ok" << std::endl;
+    return EXIT_SUCCESS;
+}
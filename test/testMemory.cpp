@@ -0,0 +1,150 @@
+/////////////////////////////////////////////////////////////////
+/// @file      testMemory.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Check the memory each display object builder uses per vertex
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Grids.h>
+#include <DDDisplayObjects/Lines.h>
+#include <DDDisplayObjects/Memory.h>
+#include <DDDisplayObjects/MeshGrid.h>
+#include <DDDisplayObjects/Points.h>
+#include <DDDisplayObjects/Triads.h>
+#include <DDDisplayObjects/Voxels.h>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/NodeVisitor>
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Counts the vertices in a scene
+/////////////////////////////////////////////////////////////////
+class CountVertices : public osg::NodeVisitor
+{
+  public:
+
+    /// @brief   Constructor
+    CountVertices() :
+        osg::NodeVisitor(osg::NodeVisitor::TRAVERSE_ALL_CHILDREN),
+        vertices(0)
+    {
+    };
+
+    /// @brief   Count the vertices of the geometries
+    virtual void apply(osg::Geode& geode)
+    {
+        for ( unsigned int ii(0) ; ii<geode.getNumDrawables() ; ++ii )
+        {
+            const osg::Geometry* geometry( geode.getDrawable(ii)->asGeometry() );
+            if ( (nullptr != geometry) && (nullptr != geometry->getVertexArray()) )
+                vertices += geometry->getVertexArray()->getNumElements();
+        }
+    };
+
+    /// The number of vertices
+    size_t vertices;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Check the bytes per vertex of a built node
+/// @param   name What was built
+/// @param   node The node
+/// @param   most The most bytes per vertex it may use
+/// @return  boolean True if it is within the limit
+/////////////////////////////////////////////////////////////////
+bool check(const std::string& name,
+           const osg::ref_ptr<osg::Node>& node,
+           const double& most)
+{
+    CountVertices counter;
+    node->accept(counter);
+    const size_t bytes( d3::getByteSize(node.get()) );
+    const double perVertex( (0 == counter.vertices) ? 0.0 : static_cast<double>(bytes)/counter.vertices );
+
+    const bool ok( (0 != counter.vertices) && (perVertex <= most) );
+    std::cout << std::left << std::setw(22) << name
+              << std::right << std::setw(10) << counter.vertices << " vertices "
+              << std::setw(12) << bytes << " bytes "
+              << std::fixed << std::setprecision(2) << std::setw(7) << perVertex << " bytes/vertex"
+              << (ok ? "" : "  <-- more than ") << (ok ? "" : std::to_string(most)) << std::endl;
+    return ok;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    // a float position is 12 bytes, a byte color 4 - anything over that is
+    // indices or per vertex float colors
+    static const double position(12.0);
+    static const double color(4.0);
+    static const double slack(0.01);
+
+    bool ok(true);
+
+    // points, one color each and all the same color
+    {
+        static const size_t numPoints(100000);
+        d3::PointVec_t colored, white;
+        for ( size_t ii(0) ; ii<numPoints ; ++ii )
+        {
+            const osg::Vec3d location(std::cos(0.01*ii), std::sin(0.01*ii), 1e-5*ii);
+            colored.push_back(d3::Point{location, osg::Vec4(0.5*std::cos(0.1*ii)+0.5, 0.5, 0.5, 1.0)});
+            white.push_back(d3::Point{location, d3::white()});
+        }
+        ok &= check("points",          d3::get(colored), position + color + slack);
+        ok &= check("points one color", d3::get(white),   position + slack);
+    }
+
+    // lines
+    {
+        static const size_t numLines(50000);
+        d3::LineVec_t lines;
+        for ( size_t ii(0) ; ii<numLines ; ++ii )
+            lines.push_back(d3::Line{osg::Vec3d(ii, 0, 0), osg::Vec3d(ii, 1, 0), (ii % 2) ? d3::red() : d3::blue()});
+        ok &= check("lines", d3::get(lines), position + color + slack);
+    }
+
+    // grids, triads and voxels are built from lines
+    ok &= check("grid", d3::ground(0.1, 50.0), position + slack);
+    {
+        d3::TriadVec_t triads;
+        for ( size_t ii(0) ; ii<10000 ; ++ii )
+            triads.push_back(d3::Triad{osg::Matrix::translate(ii, 0, 0)});
+        ok &= check("triads", d3::get(triads), position + color + slack);
+    }
+    {
+        d3::VoxelVec_t voxels;
+        for ( size_t ii(0) ; ii<10000 ; ++ii )
+            voxels.push_back(d3::Voxel{osg::Vec3d(ii, 0, 0), osg::Vec3d(ii+1, 1, 1), d3::green()});
+        ok &= check("voxels", d3::get(voxels), position + slack);
+    }
+
+    // a mesh is indexed, two quads' worth of 32 bit indices per vertex at most
+    {
+        static const unsigned int width(300);
+        d3::MeshGrid mesh{d3::PointVec_t(), std::vector<osg::Vec3d>(1, osg::Vec3d(0, 0, 1)), width, true};
+        for ( unsigned int xx(0) ; xx<width ; ++xx )
+            for ( unsigned int yy(0) ; yy<width ; ++yy )
+                mesh.points.push_back(d3::Point{osg::Vec3d(xx, yy, std::sin(0.1*xx)), osg::Vec4(0.0, 0.5, 1.0*yy/width, 0.5)});
+        ok &= check("mesh grid", d3::get(mesh), position + color + 4*sizeof(GLuint) + slack);
+    }
+
+    if ( not ok )
+    {
+        std::cerr << "BUMMER: some builders use more memory than they should" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
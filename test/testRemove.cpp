@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////////
+/// @file      testRemove.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Check that removing from the display gives the memory back, and
+///            that a handle to a removed name shows what is added to it next
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayInterface/DisplayInterface.h>
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Grids.h>
+#include <DDDisplayObjects/Points.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The resident memory of the process
+/// @return  double The resident memory in megabytes
+/////////////////////////////////////////////////////////////////
+double residentMb()
+{
+    size_t total(0), resident(0);
+    std::ifstream statm("/proc/self/statm");
+    statm >> total >> resident;
+    return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Wait for the display to apply everything and draw a few frames
+/////////////////////////////////////////////////////////////////
+void settle()
+{
+    d3::di().flush().wait();
+    d3::di().requestRedraw();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Is a node in the scene under the root, with nothing on the way
+///          hidden
+/// @param   node The node
+/// @param   root The root of the scene
+/// @return  boolean True if it would be drawn
+/////////////////////////////////////////////////////////////////
+bool shown(const osg::ref_ptr<osg::Node>& node,
+           const osg::ref_ptr<osg::Group>& root)
+{
+    for ( const osg::NodePath& path : node->getParentalNodePaths() )
+    {
+        if ( path.empty() || (path.front() != root.get()) ) continue;
+
+        bool visible(true);
+        for ( const osg::Node* onPath : path )
+            if ( 0 == onPath->getNodeMask() ) visible = false;
+        if ( visible ) return true;
+    }
+    return false;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    static const size_t numClouds(20);
+    static const size_t numPoints(250000);
+
+    d3::di().add( "ground", d3::ground() );
+    settle();
+    const double before( residentMb() );
+
+    // big clouds, the only references to them are in the display
+    for ( size_t ii(0) ; ii<numClouds ; ++ii )
+    {
+        d3::PointVec_t points;
+        points.reserve(numPoints);
+        for ( size_t jj(0) ; jj<numPoints ; ++jj )
+            points.push_back(d3::Point{osg::Vec3d(0.001*(jj%1000), 0.001*(jj/1000), 0.1*ii), d3::white()});
+        d3::di().add( "memory::cloud " + std::to_string(ii), d3::get(points) );
+    }
+    settle();
+    const double loaded( residentMb() );
+
+    // one by name, then the rest by prefix
+    d3::di().remove( "memory::cloud 0" );
+    settle();
+    const double removed( residentMb() );
+
+    d3::di().clear( "memory::cloud" );
+    settle();
+    const double cleared( residentMb() );
+
+    // a handle to a removed name adds it back
+    const osg::ref_ptr<osg::Node> first( d3::get(d3::Point{osg::Vec3d(0.0, 0.0, 1.0), d3::red()}) );
+    const osg::ref_ptr<osg::Node> second( d3::get(d3::Point{osg::Vec3d(0.0, 0.0, 1.0), d3::green()}) );
+    d3::Handle handle( d3::di().handle("memory::handle") );
+    d3::di().add( handle, first );
+    d3::di().remove( "memory::handle" );
+    d3::di().add( handle, second );
+    settle();
+
+    d3::di().lock();
+    const bool firstGone( first->getParents().empty() );
+    const bool secondShown( shown(second, d3::di().getRootGroup()) );
+    d3::di().unlock();
+
+    std::cout << "resident memory (MB):" << std::endl
+              << "  before the clouds:      " << before << std::endl
+              << "  with " << numClouds << " clouds:         " << loaded << std::endl
+              << "  after removing one:     " << removed << std::endl
+              << "  after clearing the rest: " << cleared << std::endl;
+
+    if ( not firstGone || not secondShown )
+    {
+        std::cerr << "ERROR - after removing its name, the handle "
+                  << (firstGone ? "" : "kept the removed node ")
+                  << (secondShown ? "" : "did not show the re-added node") << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // at least half of what the clouds took should be back
+    if ( (cleared - before) > 0.5*(loaded - before) )
+    {
+        std::cerr << "ERROR - clearing the clouds gave back "
+                  << (loaded - cleared) << " of " << (loaded - before) << " MB" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
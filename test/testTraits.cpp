@@ -0,0 +1,180 @@
+/////////////////////////////////////////////////////////////////
+/// @file      testTraits.cpp
+/// @author    Chris L Baker (clb) <chris@chimail.net>
+/// @date      2026.10.17
+/// @brief     Check that foreign point and pose types draw like the d3 ones
+///
+/// @attention Copyright (C) 2026
+/// @attention All rights reserved
+/////////////////////////////////////////////////////////////////
+
+#include <DDDisplayObjects/Colors.h>
+#include <DDDisplayObjects/Traits.h>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <string>
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A point like a PCL PointXYZRGBA
+/////////////////////////////////////////////////////////////////
+struct PclPoint
+{
+    float         x, y, z;
+    unsigned char b, g, r, a;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A point like a PCL PointXYZI - no color
+/////////////////////////////////////////////////////////////////
+struct PclIntensity
+{
+    float x, y, z;
+    float intensity;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A 4x4 transform like an Eigen Isometry3d (column vectors)
+/////////////////////////////////////////////////////////////////
+struct EigenTransform
+{
+    /// @brief   The matrix
+    struct Matrix
+    {
+        double values[4][4];
+        double operator()(int row, int col) const { return values[row][col]; };
+    };
+
+    const Matrix& matrix() const { return m; };
+
+    Matrix m;
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   A sample that needs its own specialization
+/////////////////////////////////////////////////////////////////
+struct Sample
+{
+    double pos[3];
+};
+
+namespace d3
+{
+namespace traits
+{
+template<>
+struct position<Sample>
+{
+    static osg::Vec3f get(const Sample& sample) { return osg::Vec3f(sample.pos[0], sample.pos[1], sample.pos[2]); };
+};
+} // namespace traits
+} // namespace d3
+
+/////////////////////////////////////////////////////////////////
+/// @brief   The geometry of a built node
+/////////////////////////////////////////////////////////////////
+const osg::Geometry* geometryOf(const osg::ref_ptr<osg::Node>& node)
+{
+    const osg::Geode* geode( node ? node->asGeode() : nullptr );
+    if ( (nullptr == geode) || (1 != geode->getNumDrawables()) ) return nullptr;
+    return geode->getDrawable(0)->asGeometry();
+};
+
+/////////////////////////////////////////////////////////////////
+/// @brief   Do two nodes have the same vertices and colors
+/////////////////////////////////////////////////////////////////
+bool same(const std::string& name,
+          const osg::ref_ptr<osg::Node>& lhs,
+          const osg::ref_ptr<osg::Node>& rhs)
+{
+    const osg::Geometry* lg( geometryOf(lhs) );
+    const osg::Geometry* rg( geometryOf(rhs) );
+    bool ok( (nullptr != lg) && (nullptr != rg) );
+    for ( int ii(0) ; ok && (ii<2) ; ++ii )
+    {
+        const osg::Array* la( (0 == ii) ? lg->getVertexArray() : lg->getColorArray() );
+        const osg::Array* ra( (0 == ii) ? rg->getVertexArray() : rg->getColorArray() );
+        ok = (nullptr != la) && (nullptr != ra) &&
+             (la->getTotalDataSize() == ra->getTotalDataSize()) &&
+             (0 == std::memcmp(la->getDataPointer(), ra->getDataPointer(), la->getTotalDataSize()));
+    }
+
+    std::cout << name << (ok ? ": ok" : ": DIFFERENT") << std::endl;
+    return ok;
+};
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+int main()
+{
+    bool ok(true);
+
+    // PCL style points with and without colors, in any container
+    {
+        d3::PointVec_t points, white;
+        std::vector<PclPoint> pcl;
+        std::deque<PclIntensity> intensities;
+        for ( int ii(0) ; ii<100 ; ++ii )
+        {
+            const osg::Vec3f location(ii, 2*ii, 0.5*ii);
+            const unsigned char red( static_cast<unsigned char>(2*ii) );
+            points.push_back(d3::Point{location, osg::Vec4(red/255.0, 0.0, 1.0, 1.0)});
+            white.push_back(d3::Point{location, d3::white()});
+            pcl.push_back(PclPoint{location.x(), location.y(), location.z(), 255, 0, red, 255});
+            intensities.push_back(PclIntensity{location.x(), location.y(), location.z(), 1.0f});
+        }
+        ok &= same("pcl points",       d3::get(points), d3::get(pcl));
+        ok &= same("colorless points", d3::get(white),  d3::get(intensities));
+
+        std::list<osg::Vec3f> vectors;
+        for ( const d3::Point& point : white ) vectors.push_back(point.location);
+        ok &= same("vectors", d3::get(white), d3::get(vectors));
+
+        std::vector<Sample> samples;
+        for ( const d3::Point& point : white ) samples.push_back(Sample{{point.location.x(), point.location.y(), point.location.z()}});
+        ok &= same("specialized", d3::get(white), d3::get(samples));
+    }
+
+    // pairs of positions as lines
+    {
+        d3::LineVec_t lines;
+        std::vector<std::pair<osg::Vec3f, osg::Vec3d>> pairs;
+        for ( int ii(0) ; ii<50 ; ++ii )
+        {
+            lines.push_back(d3::Line{osg::Vec3d(ii, 0, 0), osg::Vec3d(ii, 1, 0), d3::white()});
+            pairs.push_back(std::make_pair(osg::Vec3f(ii, 0, 0), osg::Vec3d(ii, 1, 0)));
+        }
+        ok &= same("line pairs", d3::get(lines), d3::get(pairs));
+    }
+
+    // column vector transforms as triads
+    {
+        d3::TriadVec_t triads;
+        std::vector<EigenTransform> transforms;
+        for ( int ii(0) ; ii<20 ; ++ii )
+        {
+            const osg::Matrixd pose( osg::Matrixd::rotate(0.1*ii, osg::Vec3d(0, 0, 1)) * osg::Matrixd::translate(ii, 0, 0) );
+            triads.push_back(d3::Triad{pose});
+
+            EigenTransform transform;
+            for ( int row(0) ; row<4 ; ++row )
+                for ( int col(0) ; col<4 ; ++col )
+                    transform.m.values[row][col] = pose(col, row);
+            transforms.push_back(transform);
+        }
+        ok &= same("transforms", d3::get(triads, 0.5), d3::get(transforms, 0.5));
+    }
+
+    if ( not ok )
+    {
+        std::cerr << "BUMMER: the traits don't draw like the d3 types" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}